@@ -0,0 +1,219 @@
+// Compares per-byte cost of virtual and statically dispatched bases
+//
+// Both variants run on the same zero-cost fake lines, so the difference comes
+// down to the dispatch of hardware access.
+
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <numeric>
+#include <zusi/zusi.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#endif
+
+namespace {
+
+constexpr auto iterations{2000uz};
+constexpr auto block_size{256uz};
+
+// Cycle counter if available, nanoseconds otherwise
+uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+    std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Decoder response to a CV-Read of a whole block
+struct TxLines {
+  TxLines() {
+    auto it{begin(bits)};
+    *it++ = false; // ACK valid
+    *it++ = true;  // ACK
+    *it++ = true;  // Busy
+    std::array<uint8_t, block_size + 1uz> bytes{};
+    std::iota(begin(bytes), end(bytes) - 1, 0u);
+    bytes.back() = zusi::crc8({cbegin(bytes), block_size});
+    for (auto byte : bytes)
+      for (auto i{0uz}; i < CHAR_BIT; ++i) *it++ = byte >> i & 1u;
+  }
+
+  void transmitBytes(std::span<uint8_t const>, zusi::Mbps mbps) const {
+    if (mbps != zusi::Mbps::_0_1) pos = 0uz;
+  }
+
+  bool readData() const { return bits[pos++]; }
+
+  std::array<bool, 3uz + (block_size + 1uz) * CHAR_BIT> bits{};
+  mutable size_t pos{};
+};
+
+class VirtualTx : public zusi::tx::Base {
+  void transmitBytes(std::span<uint8_t const> bytes,
+                     zusi::Mbps mbps) const final {
+    _lines.transmitBytes(bytes, mbps);
+  }
+  void spiMaster() const final {}
+  void gpioInput() const final {}
+  void gpioOutput() const final {}
+  void writeClock(bool) const final {}
+  void writeData(bool) const final {}
+  bool readData() const final { return _lines.readData(); }
+  void delayUs(uint32_t) const final {}
+
+  TxLines _lines;
+};
+
+class StaticTx : public zusi::tx::StaticBase<StaticTx> {
+  friend zusi::tx::StaticBase<StaticTx>;
+
+  void transmitBytes(std::span<uint8_t const> bytes, zusi::Mbps mbps) const {
+    _lines.transmitBytes(bytes, mbps);
+  }
+  void spiMaster() const {}
+  void gpioInput() const {}
+  void gpioOutput() const {}
+  void writeClock(bool) const {}
+  void writeData(bool) const {}
+  bool readData() const { return _lines.readData(); }
+  void delayUs(uint32_t) const {}
+
+  TxLines _lines;
+};
+
+// Host sending ZPP-Write blocks
+struct RxLines {
+  RxLines() {
+    std::array<uint8_t, block_size> data{};
+    std::iota(begin(data), end(data), 0u);
+    packet = zusi::make_zpp_write_packet(block_size - 1uz, 0u, data);
+  }
+
+  std::optional<uint8_t> receiveByte() const {
+    if (pos < size(packet)) return packet[pos++];
+    else if (pos++ == size(packet)) return zusi::resync_byte;
+    else return std::nullopt;
+  }
+
+  zusi::Packet packet{};
+  mutable size_t pos{};
+};
+
+class VirtualRx : public zusi::rx::Base {
+public:
+  RxLines _lines;
+
+private:
+  uint8_t readCv(uint32_t) const final { return 0u; }
+  void writeCv(uint32_t, uint8_t) final {}
+  void eraseZpp() final {}
+#if ZUSI_RX_CHUNK_SIZE
+  void stageZpp(uint32_t, std::span<uint8_t const>) final {}
+  void commitZpp() final {}
+  void discardZpp() final {}
+#else
+  void writeZpp(uint32_t, std::span<uint8_t const>) final {}
+#endif
+  zusi::Features features() const final { return {}; }
+  void exit(uint8_t) final {}
+  bool loadCodeValid(std::span<uint8_t const, 4uz>) const final {
+    return true;
+  }
+  bool addressValid(uint32_t) const final { return true; }
+#if ZUSI_RX_EVENT_LOG_SIZE
+  uint32_t timestamp() const final { return 0u; }
+#endif
+  std::optional<uint8_t> receiveByte() const final {
+    return _lines.receiveByte();
+  }
+  bool waitClock(bool) const final { return true; }
+  void writeData(bool) const final {}
+  void spiSlave() const final {}
+  void gpioOutput() const final {}
+};
+
+class StaticRx : public zusi::rx::StaticBase<StaticRx> {
+  friend zusi::rx::StaticBase<StaticRx>;
+
+public:
+  RxLines _lines;
+
+private:
+  uint8_t readCv(uint32_t) const { return 0u; }
+  void writeCv(uint32_t, uint8_t) {}
+  void eraseZpp() {}
+#if ZUSI_RX_CHUNK_SIZE
+  void stageZpp(uint32_t, std::span<uint8_t const>) {}
+  void commitZpp() {}
+  void discardZpp() {}
+#else
+  void writeZpp(uint32_t, std::span<uint8_t const>) {}
+#endif
+  zusi::Features features() const { return {}; }
+  void exit(uint8_t) {}
+  bool loadCodeValid(std::span<uint8_t const, 4uz>) const { return true; }
+  bool addressValid(uint32_t) const { return true; }
+#if ZUSI_RX_EVENT_LOG_SIZE
+  uint32_t timestamp() const { return 0u; }
+#endif
+  std::optional<uint8_t> receiveByte() const { return _lines.receiveByte(); }
+  bool waitClock(bool) const { return true; }
+  void writeData(bool) const {}
+  void spiSlave() const {}
+  void gpioOutput() const {}
+};
+
+// Read a block of CVs repeatedly
+template<typename T>
+double tx_per_byte(T const& tx) {
+  std::array<uint8_t, block_size> cvs{};
+  auto const then{now()};
+  for (auto i{0uz}; i < iterations; ++i)
+    if (!tx.readCv(0u, cvs)) return 0.0;
+  return static_cast<double>(now() - then) / (iterations * block_size);
+}
+
+// Receive a ZPP-Write block repeatedly
+template<typename T>
+double rx_per_byte(T& rx) {
+  auto const then{now()};
+  for (auto i{0uz}; i < iterations; ++i) {
+    rx._lines.pos = 0uz;
+    while (rx._lines.pos <= size(rx._lines.packet)) rx.receive();
+    for (auto j{0uz}; j < 4uz; ++j) rx.receive(); // ACK, busy
+  }
+  return static_cast<double>(now() - then) /
+         (iterations * size(rx._lines.packet));
+}
+
+} // namespace
+
+int main() {
+#if defined(__x86_64__) || defined(__i386__)
+  auto const unit{"cycles"};
+#else
+  auto const unit{"ns"};
+#endif
+  // Referencing through the base prevents devirtualization
+  VirtualTx virtual_tx;
+  zusi::tx::Base const& tx{virtual_tx};
+  StaticTx static_tx;
+  std::printf("tx::Base        CV-Read  %6.1f %s/byte\n", tx_per_byte(tx), unit);
+  std::printf("tx::StaticBase  CV-Read  %6.1f %s/byte\n",
+              tx_per_byte(static_tx),
+              unit);
+
+  VirtualRx virtual_rx;
+  StaticRx static_rx;
+  std::printf("rx::Base        ZPP-Write %5.1f %s/byte\n",
+              rx_per_byte(virtual_rx),
+              unit);
+  std::printf("rx::StaticBase  ZPP-Write %5.1f %s/byte\n",
+              rx_per_byte(static_rx),
+              unit);
+}
@@ -0,0 +1,57 @@
+#include "image.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if __has_include(<sys/mman.h>)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#  define ZPP_LOAD_MMAP 1
+#else
+#  define ZPP_LOAD_MMAP 0
+#endif
+
+Image::Image(std::filesystem::path const& path) {
+  auto const size{std::filesystem::file_size(path)};
+  if (!size) return;
+#if ZPP_LOAD_MMAP
+  if (auto const fd{::open(path.c_str(), O_RDONLY)}; fd >= 0) {
+    auto const addr{::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+    ::close(fd);
+    if (addr != MAP_FAILED) {
+      ::madvise(addr, size, MADV_SEQUENTIAL);
+      _bytes = {static_cast<uint8_t const*>(addr), size};
+      return;
+    }
+  }
+#endif
+  std::ifstream ifs{path, std::ios::binary};
+  if (!ifs) throw std::runtime_error{"Can't open " + path.string()};
+  _buffer.resize(size);
+  ifs.read(reinterpret_cast<char*>(data(_buffer)),
+           static_cast<std::streamsize>(size));
+  _bytes = _buffer;
+}
+
+Image::~Image() {
+#if ZPP_LOAD_MMAP
+  if (empty(_buffer) && !empty(_bytes))
+    ::munmap(const_cast<uint8_t*>(data(_bytes)), size(_bytes));
+#endif
+}
+
+void Image::readAhead([[maybe_unused]] size_t offset,
+                      [[maybe_unused]] size_t count) const {
+#if ZPP_LOAD_MMAP
+  if (!empty(_buffer) || offset >= size(_bytes)) return;
+  // madvise requires page aligned addresses
+  static auto const page_size{static_cast<size_t>(::sysconf(_SC_PAGESIZE))};
+  auto const first{offset / page_size * page_size};
+  auto const last{std::min(offset + count, size(_bytes))};
+  ::madvise(const_cast<uint8_t*>(data(_bytes)) + first,
+            last - first,
+            MADV_WILLNEED);
+#endif
+}
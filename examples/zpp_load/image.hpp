@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+// Read-only view of a file, memory-mapped where possible
+class Image {
+public:
+  explicit Image(std::filesystem::path const& path);
+  ~Image();
+
+  Image(Image const&) = delete;
+  Image& operator=(Image const&) = delete;
+
+  // Whole file
+  std::span<uint8_t const> bytes() const { return _bytes; }
+
+  // Hint that bytes starting at offset are going to be read soon
+  void readAhead(size_t offset, size_t count) const;
+
+private:
+  std::span<uint8_t const> _bytes{};
+  std::vector<uint8_t> _buffer{}; // Fallback if mmap is not available
+};
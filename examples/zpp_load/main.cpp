@@ -1,85 +1,553 @@
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <zusi/zusi.hpp>
+#include "image.hpp"
+#include "simulated_bus.hpp"
 
-class Receiver : public zusi::rx::Base {
-  // Receive a byte
-  std::optional<uint8_t> receiveByte() const final { return 0u; }
+namespace {
 
-  // Read a CV at address
-  uint8_t readCv(uint32_t addr) const final { return 0u; }
+// Blocks get read-ahead this far in front of the block being transmitted
+constexpr size_t read_ahead{1uz << 20uz};
 
-  // Write a CV at address
-  void writeCv(uint32_t addr, uint8_t byte) final {}
+// Block size of ZPP-Write
+constexpr size_t block_size{256uz};
 
-  // Erase ZPP
-  void eraseZpp() final {}
+struct Options {
+  char const* path{};
+  std::string_view backend{"sim"};
+  size_t offset{};
+  size_t size{SIZE_MAX};
+  zusi::tx::Timing timing{zusi::tx::mx644_timing};
+  size_t burst{16uz};
+  bool fast_entry{};
+  bool homogeneous{};
+  bool compress{};
+  bool fec{};
+  bool dedup{};
+  bool verify{};
+  std::optional<uint32_t> developer_code{};
+  char const* journal{};
+  size_t abort_after{SIZE_MAX};
+};
+
+struct Stats {
+  char const* name{};
+  std::chrono::nanoseconds wall{};
+  std::chrono::nanoseconds bus{};
+};
 
-  // Write ZPP
-  void writeZpp(uint32_t addr, std::span<uint8_t const> bytes) final {}
+void usage() {
+  std::puts("Usage: ZUSIZppLoad [--backend sim] [--timing mx644|ulf|fast]\n"
+            "                   [--fast-entry] [--homogeneous] [--burst N]\n"
+            "                   [--compress] [--fec] [--dedup] [--verify]\n"
+            "                   [--developer-code N] [--journal PATH]\n"
+            "                   [--abort-after N] [--offset N] [--size N]\n"
+            "                   FILE\n"
+            "\n"
+            "Writes FILE (or --size bytes of it starting at --offset) as ZPP\n"
+            "flash data through a backend and prints timing statistics.\n"
+            "--fast-entry tries the fast entry sequence first, only use it\n"
+            "if all decoders on the bus support it. --homogeneous states\n"
+            "that all decoders on the bus answer the Capabilities query.\n"
+            "If the decoder supports it, N blocks (default 16) get written\n"
+            "per ZPP-Write-Burst, --burst 1 disables bursts. All blocks\n"
+            "get framed up front on all cores, --compress sends those which\n"
+            "get smaller as ZPP-Write-Compressed. --fec sends the others as\n"
+            "ZPP-Write-FEC instead of bursts. --dedup sends blocks which\n"
+            "repeat earlier ones as ZPP-Copy. --verify compares CRC32s of\n"
+            "the written flash and erases and rewrites mismatching\n"
+            "blocks.\n"
+            "Only the range of the image gets erased if the decoder\n"
+            "supports it. --developer-code checks the load code before\n"
+            "erasing. Decoders answering the Capabilities query switch to\n"
+            "their fastest common speed. Without an answer or without\n"
+            "--homogeneous only ZPP-Write and ZPP-Erase get used.\n"
+            "--journal records progress in PATH, an interrupted update of\n"
+            "the same image continues without erasing. --abort-after stops\n"
+            "writing after N bytes to simulate a dropped link.");
+}
 
-  // Return value of features query
-  zusi::Features features() const final { return {}; }
+std::optional<size_t> parse_size(std::string_view str) {
+  size_t value{};
+  auto const base{str.starts_with("0x") ? 16 : 10};
+  if (base == 16) str.remove_prefix(2uz);
+  auto const [ptr, ec]{
+    std::from_chars(data(str), data(str) + size(str), value, base)};
+  if (ec != std::errc{} || ptr != data(str) + size(str)) return std::nullopt;
+  return value;
+}
 
-  // Exit
-  void exit(uint8_t flags) final {}
+std::optional<zusi::tx::Timing> parse_timing(std::string_view str) {
+  if (str == "mx644") return zusi::tx::mx644_timing;
+  else if (str == "ulf") return zusi::tx::ulf_timing;
+  else if (str == "fast") return zusi::tx::fast_timing;
+  return std::nullopt;
+}
 
-  // Check if the load code is valid
-  bool loadCodeValid(std::span<uint8_t const, 4uz> developer_code) const final {
-    return true;
+std::optional<Options> parse_options(int argc, char* argv[]) {
+  Options options{};
+  for (auto i{1}; i < argc; ++i) {
+    std::string_view const arg{argv[i]};
+    if (arg == "--backend" && i + 1 < argc) options.backend = argv[++i];
+    else if (arg == "--timing" && i + 1 < argc) {
+      if (auto const value{parse_timing(argv[++i])}) options.timing = *value;
+      else return std::nullopt;
+    } else if (arg == "--burst" && i + 1 < argc) {
+      if (auto const value{parse_size(argv[++i])};
+          value && *value && *value <= zusi::zpp_write_burst_max_blocks)
+        options.burst = *value;
+      else return std::nullopt;
+    } else if (arg == "--fast-entry") options.fast_entry = true;
+    else if (arg == "--homogeneous") options.homogeneous = true;
+    else if (arg == "--compress") options.compress = true;
+    else if (arg == "--fec") options.fec = true;
+    else if (arg == "--dedup") options.dedup = true;
+    else if (arg == "--verify") options.verify = true;
+    else if (arg == "--developer-code" && i + 1 < argc) {
+      auto const value{parse_size(argv[++i])};
+      if (value && *value <= UINT32_MAX)
+        options.developer_code = static_cast<uint32_t>(*value);
+      else return std::nullopt;
+    } else if (arg == "--journal" && i + 1 < argc) options.journal = argv[++i];
+    else if (arg == "--abort-after" && i + 1 < argc) {
+      if (auto const value{parse_size(argv[++i])}) options.abort_after = *value;
+      else return std::nullopt;
+    } else if (arg == "--offset" && i + 1 < argc) {
+      if (auto const value{parse_size(argv[++i])}) options.offset = *value;
+      else return std::nullopt;
+    } else if (arg == "--size" && i + 1 < argc) {
+      if (auto const value{parse_size(argv[++i])}) options.size = *value;
+      else return std::nullopt;
+    } else if (!arg.starts_with("-") && !options.path) options.path = argv[i];
+    else return std::nullopt;
   }
+  if (!options.path) return std::nullopt;
+  return options;
+}
+
+// Hardware backends derive from zusi::tx::Base and get added here
+std::unique_ptr<zusi::tx::Base> make_backend(std::string_view name) {
+  if (name == "sim") return std::make_unique<SimulatedBus>();
+  return nullptr;
+}
+
+std::chrono::nanoseconds bus_time(zusi::tx::Base const& backend) {
+  if (auto const sim{dynamic_cast<SimulatedBus const*>(&backend)})
+    return sim->busTime();
+  return {};
+}
+
+// Run a phase and record its wall and bus time
+template<typename F>
+auto measure(std::vector<Stats>& stats,
+             char const* name,
+             zusi::tx::Base const& backend,
+             F&& f) {
+  auto const bus_then{bus_time(backend)};
+  auto const then{std::chrono::steady_clock::now()};
+  auto retval{std::invoke(std::forward<F>(f))};
+  stats.push_back({.name = name,
+                   .wall = std::chrono::steady_clock::now() - then,
+                   .bus = bus_time(backend) - bus_then});
+  return retval;
+}
 
-  // Check if the received address is valid
-  bool addressValid(uint32_t addr) const final { return true; }
+double ms(std::chrono::nanoseconds ns) {
+  return std::chrono::duration<double, std::milli>{ns}.count();
+}
 
-  // Wait till clock pin equals state with a resync timeout
-  bool waitClock(bool state) const final { return true; }
+double kib_per_s(size_t bytes, std::chrono::nanoseconds ns) {
+  auto const s{std::chrono::duration<double>{ns}.count()};
+  return s > 0.0 ? static_cast<double>(bytes) / 1024.0 / s : 0.0;
+}
 
-  // Write data line
-  void writeData(bool state) const final {}
+void print(std::vector<Stats> const& stats, size_t bytes, size_t blocks) {
+  std::printf("%-10s %12s %12s\n", "Phase", "Wall [ms]", "Bus [ms]");
+  Stats total{.name = "Total"};
+  for (auto const& s : stats) {
+    std::printf("%-10s %12.3f %12.3f\n", s.name, ms(s.wall), ms(s.bus));
+    total.wall += s.wall;
+    total.bus += s.bus;
+  }
+  std::printf(
+    "%-10s %12.3f %12.3f\n", total.name, ms(total.wall), ms(total.bus));
+  auto const write{std::ranges::find_if(
+    stats, [](auto const& s) { return std::string_view{s.name} == "Write"; })};
+  if (write == cend(stats)) return;
+  std::printf("\n%zu bytes in %zu blocks\n", bytes, blocks);
+  std::printf("Write throughput wall %.1f KiB/s, bus %.1f KiB/s\n",
+              kib_per_s(bytes, write->wall),
+              kib_per_s(bytes, write->bus));
+  if (blocks)
+    std::printf("Per block wall %.3f ms, bus %.3f ms\n",
+                ms(write->wall) / static_cast<double>(blocks),
+                ms(write->bus) / static_cast<double>(blocks));
+}
 
-  // Switch to SPI slave
-  void spiSlave() const final {}
+// Block at index padded to full size
+std::array<uint8_t, block_size> padded_block(std::span<uint8_t const> flash,
+                                             size_t index) {
+  std::array<uint8_t, block_size> block;
+  block.fill(0xFFu);
+  auto const bytes{flash.subspan(index * block_size)};
+  std::ranges::copy(bytes.first(std::min(block_size, size(bytes))),
+                    begin(block));
+  return block;
+}
 
-  // Switch to GPIO output
-  void gpioOutput() const final {}
+// Call function for every index on all cores
+void parallel_for_each(size_t count, std::function<void(size_t)> const& f) {
+  auto const threads{std::max(std::thread::hardware_concurrency(), 1u)};
+  std::vector<std::jthread> workers;
+  for (auto t{0u}; t < threads; ++t)
+    workers.emplace_back([&, t] {
+      for (auto i{static_cast<size_t>(t)}; i < count; i += threads) f(i);
+    });
+}
 
-  // Optional, blink front- and rear lights
-  void toggleLights() const final {}
+// Progress of writing blocks
+struct Progress {
+  size_t first{};                        // Address to start at
+  size_t stop{SIZE_MAX};                 // Give up after this many bytes
+  zusi::tx::ZppJournal const* journal{}; // Journal to record in
 };
 
-class Transmitter : public zusi::tx::Base {
-  /// Transmit byte at specific transmission speed
-  void transmitBytes(std::span<uint8_t const> bytes,
-                     zusi::Mbps mbps) const final {}
+// Transmit all blocks, padding the last one to full size
+//
+// Blocks which have been compressed are sent as ZPP-Write-Compressed straight
+// from the framed image. All others are grouped into bursts of up to burst
+// blocks each, a burst of a single block is sent as framed ZPP-Write or as
+// ZPP-Write-FEC if fec is set. Runs of blocks repeating earlier ones are sent
+// as ZPP-Copy instead. Every acknowledged write gets recorded in the journal.
+std::expected<bool, std::errc>
+write_blocks(zusi::tx::Base& backend,
+             Image const& image,
+             std::span<uint8_t const> flash,
+             size_t offset,
+             size_t burst,
+             bool fec,
+             zusi::tx::FramedImage const& framed,
+             std::span<zusi::tx::ZppCopy const> copies,
+             Progress const& progress) {
+  auto const blocks{(size(flash) + block_size - 1uz) / block_size};
+  std::vector<uint8_t> padded;
+  auto copy{std::ranges::lower_bound(
+    copies, progress.first, {}, &zusi::tx::ZppCopy::dst)};
+  auto const copied{[&](size_t i) {
+    return copy != cend(copies) && copy->dst == i * block_size;
+  }};
+  for (auto i{progress.first / block_size}, ahead{0uz}; i < blocks;) {
+    if (i * block_size - progress.first >= progress.stop) {
+      std::fprintf(stderr, "Aborted at 0x%08zX\n", i * block_size);
+      return std::unexpected{std::errc::connection_reset};
+    }
+    if (i * block_size >= ahead) {
+      image.readAhead(offset + i * block_size + read_ahead, read_ahead);
+      ahead = i * block_size + read_ahead;
+    }
+    auto const addr{static_cast<uint32_t>(i * block_size)};
+    std::expected<bool, std::errc> result{true};
+    auto count{1uz};
+    if (!framed.compressed(i))
+      while (count < burst && i + count < blocks &&
+             !framed.compressed(i + count) && !copied(i + count))
+        ++count;
+    if (copied(i)) {
+      result = backend.copyZpp(
+        copy->src, copy->dst, static_cast<uint32_t>(copy->size));
+      i += copy++->size / block_size;
+    } else if (count == 1uz && fec && !framed.compressed(i)) {
+      result = backend.writeZppFec(
+        addr,
+        flash.subspan(i * block_size,
+                      std::min(block_size, size(flash) - i * block_size)));
+      ++i;
+    } else if (count == 1uz) {
+      if (auto const feedback{backend.transmit(framed[i])}; !feedback)
+        result = std::unexpected{feedback.error()};
+      ++i;
+    } else {
+      auto bytes{flash.subspan(
+        i * block_size, std::min(count * block_size, size(flash) - addr))};
+      if (size(bytes) % block_size) {
+        padded.assign(cbegin(bytes), cend(bytes));
+        padded.resize((size(bytes) / block_size + 1uz) * block_size, 0xFFu);
+        bytes = padded;
+      }
+      result = backend.writeZppBurst(addr, bytes);
+      i += count;
+    }
+    if (!result) {
+      std::fprintf(stderr, "ZPP-Write at 0x%08X failed\n", addr);
+      return result;
+    }
+    if (progress.journal)
+      progress.journal->acknowledged(static_cast<uint32_t>(i * block_size));
+  }
+  return true;
+}
 
-  // Switch to SPI master
-  void spiMaster() const final {}
+// Whole file or nothing if it doesn't exist
+std::vector<uint8_t> read_file(char const* path) {
+  std::vector<uint8_t> bytes;
+  if (auto const file{std::fopen(path, "rb")}) {
+    for (int c; (c = std::fgetc(file)) != EOF;)
+      bytes.push_back(static_cast<uint8_t>(c));
+    std::fclose(file);
+  }
+  return bytes;
+}
 
-  // Switch to GPIO input
-  void gpioInput() const final {}
+// Find mismatching blocks by CRC32, erase and rewrite them once
+//
+// NOR flash can only clear bits, so bad blocks have to be erased before they
+// can be rewritten. Without ZPP-Erase-Range that would erase everything.
+// Ranges get widened to whole pages, decoders erasing whole sectors are caught
+// by checking the entire image again in the end.
+std::expected<bool, std::errc> verify_blocks(zusi::tx::Base& backend,
+                                             std::span<uint8_t const> flash,
+                                             zusi::Capabilities const& caps) {
+  auto const bad{zusi::tx::find_bad_ranges(backend, 0u, flash, block_size)};
+  if (!bad) return std::unexpected{bad.error()};
+  if (empty(*bad)) return true;
+  if (!caps.zpp_erase_range) {
+    std::fprintf(stderr, "Can't rewrite blocks without ZPP-Erase-Range\n");
+    return false;
+  }
+  auto const align{std::max(block_size, caps.page_size)};
+  for (auto const& range : *bad) {
+    auto const first{range.addr / align * align};
+    auto const last{
+      std::min((range.addr + range.size + align - 1uz) / align * align,
+               (size(flash) + block_size - 1uz) / block_size * block_size)};
+    std::printf("Rewriting 0x%08zX-0x%08zX\n", first, last - 1uz);
+    auto const addr{static_cast<uint32_t>(first)};
+    if (auto const result{
+          backend.eraseZpp(addr, static_cast<uint32_t>(last - first))};
+        !result)
+      return result;
+    for (auto i{first / block_size}; i < last / block_size; ++i)
+      if (auto const result{backend.writeZpp(
+            static_cast<uint32_t>(i * block_size), padded_block(flash, i))};
+          !result)
+        return result;
+    auto const bytes{flash.subspan(first, std::min(last, size(flash)) - first)};
+    if (auto const result{backend.verifyRange(addr, bytes)};
+        !result || !*result)
+      return result;
+  }
+  auto const still_bad{
+    zusi::tx::find_bad_ranges(backend, 0u, flash, block_size)};
+  if (!still_bad) return std::unexpected{still_bad.error()};
+  return empty(*still_bad);
+}
 
-  // Switch to GPIO output
-  void gpioOutput() const final {}
+} // namespace
 
-  // Write clock line
-  void writeClock(bool state) const final {}
+int main(int argc, char* argv[]) {
+  auto const options{parse_options(argc, argv)};
+  if (!options) {
+    usage();
+    return EXIT_FAILURE;
+  }
 
-  // Write data line
-  void writeData(bool state) const final {}
+  auto const backend{make_backend(options->backend)};
+  if (!backend) {
+    std::fprintf(stderr,
+                 "Unknown backend %.*s\n",
+                 static_cast<int>(size(options->backend)),
+                 data(options->backend));
+    return EXIT_FAILURE;
+  }
+  backend->timing(options->timing);
 
-  // Read data line
-  bool readData() const final { return true; }
+  Image const image{options->path};
+  if (options->offset > size(image.bytes())) {
+    std::fprintf(stderr, "Offset exceeds file size\n");
+    return EXIT_FAILURE;
+  }
+  auto const flash{image.bytes().subspan(
+    options->offset,
+    std::min(options->size, size(image.bytes()) - options->offset))};
+  image.readAhead(options->offset, read_ahead);
 
-  // Delay microseconds
-  void delayUs(uint32_t us) const final {}
+  std::vector<Stats> stats;
+  std::expected<zusi::Features, std::errc> features;
+  if (options->fast_entry)
+    features = measure(
+      stats, "Entry", *backend, [&] { return backend->enterFast(true); });
+  else {
+    measure(stats, "Entry", *backend, [&] {
+      backend->enter();
+      return true;
+    });
+    features = measure(
+      stats, "Features", *backend, [&] { return backend->features(); });
+  }
+  if (!features) {
+    std::fprintf(stderr, "Features query failed\n");
+    return EXIT_FAILURE;
+  }
+  // Features only tell that some decoder supports a command and legacy
+  // decoders which don't answer Capabilities can't veto any of them. Unless
+  // all decoders are known to answer, stick to ZPP-Write and a full erase.
+  auto const answered{measure(stats, "Caps", *backend, [&] {
+    return backend->capabilities(options->homogeneous);
+  })};
+  auto const caps{options->homogeneous
+                    ? answered.value_or(zusi::Capabilities{})
+                    : zusi::Capabilities{}};
+  std::printf("Capabilities: burst %zu, compressed %d, CRC32 %d, erase range "
+              "%d, FEC %d, copy %d, fast response %d, fast timing %d\n\n",
+              caps.zpp_write_burst_blocks,
+              caps.zpp_write_compressed,
+              caps.zpp_crc32_query,
+              caps.zpp_erase_range,
+              caps.zpp_write_fec,
+              caps.zpp_copy,
+              caps.fast_response,
+              caps.fast_timing);
+  zusi::tx::ZppSession session{
+    .image_crc = zusi::crc32(flash),
+    .image_size = static_cast<uint32_t>(size(flash)),
+    .features = *features};
+  if (options->developer_code) {
+    zusi::uint32_2data(*options->developer_code, begin(session.developer_code));
+    auto const valid{measure(stats, "LC-DC", *backend, [&] {
+      return backend->lcDcQuery(session.developer_code);
+    })};
+    if (!valid || !*valid) {
+      std::fprintf(stderr, "Load code not valid\n");
+      backend->exit(0xFFu);
+      return EXIT_FAILURE;
+    }
+    session.load_code_valid = *valid;
+  }
+  // Blocks protected by FEC are written one by one
+  auto const fec{options->fec && caps.zpp_write_fec};
+  auto const burst{caps.zpp_write_burst && !fec
+                     ? std::min(options->burst, caps.zpp_write_burst_blocks)
+                     : 1uz};
+  auto const framed{measure(stats, "Frame", *backend, [&] {
+    return zusi::tx::FramedImage{
+      0u,
+      flash,
+      options->compress && caps.zpp_write_compressed,
+      parallel_for_each};
+  })};
+  auto count{0uz};
+  for (auto i{0uz}; i < framed.size(); ++i) count += framed.compressed(i);
+  std::printf("Framed %zu blocks (%zu compressed, %zu bytes)\n\n",
+              framed.size(),
+              count,
+              framed.arenaSize());
+  // An interrupted update of the same image continues without erasing
+  std::optional<uint32_t> resume;
+  if (options->journal)
+    if (auto const state{
+          zusi::tx::parse_zpp_journal(read_file(options->journal))})
+      resume = zusi::tx::resume_address(*state, session);
+  // Repeated blocks get copied from their first occurrence, sources are
+  // limited to blocks written by this run
+  auto const start{std::min<size_t>(resume.value_or(0u), size(flash))};
+  auto const copies{options->dedup && caps.zpp_copy
+                      ? zusi::tx::find_duplicate_blocks(
+                          static_cast<uint32_t>(start),
+                          flash.subspan(start),
+                          block_size)
+                      : std::vector<zusi::tx::ZppCopy>{}};
+  if (!empty(copies)) {
+    auto copied{0uz};
+    for (auto const& copy : copies) copied += copy.size / block_size;
+    std::printf("Deduplicated %zu blocks (%zu copies)\n\n",
+                copied,
+                size(copies));
+  }
+  // Only erase what the image occupies if possible
+  if (resume) std::printf("Resuming at 0x%08X\n\n", *resume);
+  else if (!measure(stats, "Erase", *backend, [&] {
+             return caps.zpp_erase_range
+                      ? backend->eraseZpp(0u, session.image_size)
+                      : backend->eraseZpp();
+           })) {
+    std::fprintf(stderr, "ZPP-Erase failed\n");
+    return EXIT_FAILURE;
+  }
+  // The previous journal only gets replaced once the new one holds the same
+  // resume point, an interruption before can still continue from the old one
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> journal_file{nullptr,
+                                                                &std::fclose};
+  std::optional<zusi::tx::ZppJournal> journal;
+  if (options->journal) {
+    auto const tmp{std::string{options->journal} + ".tmp"};
+    journal_file.reset(std::fopen(data(tmp), "wb"));
+    if (!journal_file) {
+      std::fprintf(stderr, "Can't open journal %s\n", data(tmp));
+      return EXIT_FAILURE;
+    }
+    journal.emplace(
+      [file = journal_file.get()](std::span<uint8_t const> bytes) {
+        std::fwrite(data(bytes), 1uz, size(bytes), file);
+        std::fflush(file);
+      },
+      session);
+    if (resume) journal->acknowledged(*resume);
+    if (std::rename(data(tmp), options->journal)) {
+      std::fprintf(stderr, "Can't replace journal %s\n", options->journal);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!measure(stats, "Write", *backend, [&] {
+        return write_blocks(*backend,
+                            image,
+                            flash,
+                            options->offset,
+                            burst,
+                            fec,
+                            framed,
+                            copies,
+                            {.first = resume.value_or(0u),
+                             .stop = options->abort_after,
+                             .journal = journal ? &*journal : nullptr});
+      }))
+    return EXIT_FAILURE;
+  if (options->verify && caps.zpp_crc32_query) {
+    auto const verified{measure(stats, "Verify", *backend, [&] {
+      return verify_blocks(*backend, flash, caps);
+    })};
+    if (!verified || !*verified) {
+      std::fprintf(stderr, "Verification failed\n");
+      return EXIT_FAILURE;
+    }
+  }
+  measure(stats, "Exit", *backend, [&] { return backend->exit(0xFFu); });
+  if (journal_file) {
+    journal_file.reset();
+    std::remove(options->journal);
+  }
 
-  /// Optional, busy phase
-  void busy() const final {}
-};
+  print(stats, size(flash), (size(flash) + block_size - 1uz) / block_size);
 
-int main() {
-  Receiver rx{};
-  rx.receive();
+  // A simulated decoder only holds what has been written since resuming
+  if (auto const sim{dynamic_cast<SimulatedBus const*>(backend.get())}) {
+    auto const& written{sim->decoder().flash()};
+    auto const first{std::min<size_t>(resume.value_or(0u), size(flash))};
+    if (size(written) < size(flash) ||
+        !std::ranges::equal(
+          flash.subspan(first),
+          std::span{written}.subspan(first, size(flash) - first))) {
+      std::fprintf(stderr, "Simulated flash does not match image\n");
+      return EXIT_FAILURE;
+    }
+  }
 
-  Transmitter tx{};
-  tx.transmit(zusi::Packet{});
-}
\ No newline at end of file
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,215 @@
+#include "simulated_bus.hpp"
+#include <algorithm>
+#include <climits>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Decoder gives up waiting after this long
+constexpr auto timeout{1s};
+
+// Clock period per transmission speed
+constexpr std::chrono::nanoseconds period(zusi::Mbps mbps) {
+  switch (mbps) {
+    case zusi::Mbps::_0_1: return 10'000ns;
+    case zusi::Mbps::_0_286: return 3'500ns;
+    case zusi::Mbps::_1_364: return 733ns;
+    case zusi::Mbps::_1_807: return 553ns;
+  }
+  return 10'000ns;
+}
+
+} // namespace
+
+uint8_t SimulatedDecoder::readCv(uint32_t addr) const {
+  return addr < size(_cvs) ? _cvs[addr] : 0u;
+}
+
+void SimulatedDecoder::writeCv(uint32_t addr, uint8_t byte) {
+  if (addr < size(_cvs)) _cvs[addr] = byte;
+}
+
+void SimulatedDecoder::eraseZpp() { std::ranges::fill(_flash, 0xFFu); }
+
+// Bytes past the end of the written flash are already erased
+void SimulatedDecoder::eraseZppRange(uint32_t addr, uint32_t count) {
+  std::span const flash{_flash};
+  auto const first{std::min<size_t>(addr, size(flash))};
+  std::ranges::fill(
+    flash.subspan(first, std::min<size_t>(count, size(flash) - first)), 0xFFu);
+}
+
+// Source bytes past the end of the written flash are erased
+void SimulatedDecoder::copyZpp(uint32_t src, uint32_t dst, uint32_t count) {
+  std::vector<uint8_t> bytes(count, 0xFFu);
+  if (src < size(_flash))
+    std::copy_n(&_flash[src],
+                std::min<size_t>(count, size(_flash) - src),
+                begin(bytes));
+  store(dst, bytes);
+}
+
+// Bytes past the end of the written flash are erased
+uint32_t SimulatedDecoder::crc32Zpp(uint32_t addr, uint32_t count) const {
+  std::span<uint8_t const> const flash{_flash};
+  auto const first{std::min<size_t>(addr, size(flash))};
+  auto const written{std::min<size_t>(count, size(flash) - first)};
+  auto crc{zusi::crc32(flash.subspan(first, written))};
+  std::array<uint8_t, 256uz> erased;
+  erased.fill(0xFFu);
+  for (auto i{written}; i < count; i += size(erased))
+    crc = zusi::crc32(
+      std::span{erased}.first(std::min(size(erased), count - i)), crc);
+  return crc;
+}
+
+#if ZUSI_RX_CHUNK_SIZE
+void SimulatedDecoder::stageZpp(uint32_t addr, std::span<uint8_t const> bytes) {
+  _staged.emplace_back(addr,
+                       std::vector<uint8_t>{cbegin(bytes), cend(bytes)});
+}
+
+void SimulatedDecoder::commitZpp() {
+  for (auto const& [addr, bytes] : _staged) store(addr, bytes);
+  _staged.clear();
+}
+
+void SimulatedDecoder::discardZpp() { _staged.clear(); }
+#else
+void SimulatedDecoder::writeZpp(uint32_t addr, std::span<uint8_t const> bytes) {
+  store(addr, bytes);
+}
+#endif
+
+zusi::Features SimulatedDecoder::features() const {
+#if ZUSI_RX_CHUNK_SIZE
+  return {0b1111'1000u, 0b1010'0010u, 0xFFu, 0xFFu};
+#else
+  return {0b1111'1000u, 0b1000'0000u, 0xFFu, 0xFFu};
+#endif
+}
+
+// Flash is simulated, so bursts of any length and fast timing are fine
+zusi::Capabilities SimulatedDecoder::capabilities() const {
+  auto caps{zusi::features2capabilities(features())};
+  caps.fast_timing = true;
+  caps.zpp_write_burst_blocks = 256uz;
+  caps.page_size = 256uz;
+  return caps;
+}
+
+#if ZUSI_RX_EVENT_LOG_SIZE
+// Microseconds since start
+uint32_t SimulatedDecoder::timestamp() const {
+  static auto const start{std::chrono::steady_clock::now()};
+  return static_cast<uint32_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start)
+      .count());
+}
+#endif
+
+std::optional<uint8_t> SimulatedDecoder::receiveByte() const {
+  std::unique_lock lock{_lines.mutex};
+  _lines.wait = Lines::Wait::Byte;
+  _lines.cv.notify_all();
+  _lines.cv.wait_for(
+    lock, timeout, [this] { return _lines.stop || !empty(_lines.bytes); });
+  _lines.wait = Lines::Wait::None;
+  if (empty(_lines.bytes)) return std::nullopt;
+  auto const byte{_lines.bytes.front()};
+  _lines.bytes.pop_front();
+  return byte;
+}
+
+bool SimulatedDecoder::waitClock(bool state) const {
+  std::unique_lock lock{_lines.mutex};
+  _lines.wait = Lines::Wait::Clock;
+  _lines.clock_wanted = state;
+  _lines.cv.notify_all();
+  auto const retval{_lines.cv.wait_for(lock, timeout, [this, state] {
+    return _lines.stop || _lines.clock == state;
+  })};
+  _lines.wait = Lines::Wait::None;
+  return retval && !_lines.stop;
+}
+
+void SimulatedDecoder::writeData(bool state) const {
+  std::scoped_lock lock{_lines.mutex};
+  _lines.data = state;
+}
+
+void SimulatedDecoder::store(uint32_t addr, std::span<uint8_t const> bytes) {
+  if (size(_flash) < addr + size(bytes))
+    _flash.resize(addr + size(bytes), 0xFFu);
+  std::ranges::copy(bytes, begin(_flash) + addr);
+}
+
+SimulatedBus::SimulatedBus()
+  : _thread{[this](std::stop_token stoken) {
+      while (!stoken.stop_requested()) _decoder.receive();
+    }} {}
+
+SimulatedBus::~SimulatedBus() {
+  _thread.request_stop();
+  {
+    std::scoped_lock lock{_lines.mutex};
+    _lines.stop = true;
+  }
+  _lines.cv.notify_all();
+}
+
+void SimulatedBus::transmitBytes(std::span<uint8_t const> bytes,
+                                 zusi::Mbps mbps) const {
+  {
+    std::scoped_lock lock{_lines.mutex};
+    _lines.bytes.insert(end(_lines.bytes), cbegin(bytes), cend(bytes));
+  }
+  _lines.cv.notify_all();
+  _bus_time += static_cast<int64_t>(size(bytes) * CHAR_BIT) * period(mbps);
+}
+
+void SimulatedBus::writeClock(bool state) const {
+  {
+    std::scoped_lock lock{_lines.mutex};
+    _lines.clock = state;
+  }
+  _lines.cv.notify_all();
+}
+
+void SimulatedBus::writeData(bool state) const {
+  std::scoped_lock lock{_lines.mutex};
+  _lines.data = state;
+}
+
+bool SimulatedBus::readData() const {
+  settle();
+  std::scoped_lock lock{_lines.mutex};
+  return _lines.data;
+}
+
+void SimulatedBus::delayUs(uint32_t us) const {
+  _bus_time += std::chrono::microseconds{us};
+  settle();
+}
+
+// Response clocked by SPI at the transmission speed
+void SimulatedBus::receiveBytes(std::span<uint8_t> bytes,
+                                zusi::Mbps mbps) const {
+  for (auto& byte : bytes) {
+    byte = 0u;
+    for (auto i{0uz}; i < CHAR_BIT; ++i) {
+      writeClock(true);
+      byte = static_cast<uint8_t>(byte | readData() << i);
+      writeClock(false);
+      settle();
+    }
+  }
+  _bus_time += static_cast<int64_t>(size(bytes) * CHAR_BIT) * period(mbps);
+}
+
+void SimulatedBus::settle() const {
+  std::unique_lock lock{_lines.mutex};
+  _lines.cv.wait(lock, [this] { return _lines.settled(); });
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <zusi/zusi.hpp>
+
+// Lines shared between host and decoder
+struct Lines {
+  enum struct Wait : uint8_t { None, Byte, Clock };
+
+  // Decoder is blocked and nothing it waits for has happened yet
+  bool settled() const {
+    return wait == Wait::Byte    ? empty(bytes)
+           : wait == Wait::Clock ? clock != clock_wanted
+                                 : false;
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<uint8_t> bytes; // SPI
+  bool clock{};
+  bool data{true};
+  Wait wait{};
+  bool clock_wanted{};
+  bool stop{};
+};
+
+// Decoder running rx::Base on its own thread
+class SimulatedDecoder : public zusi::rx::Base {
+public:
+  explicit SimulatedDecoder(Lines& lines) : _lines{lines} {}
+
+  std::vector<uint8_t> const& flash() const { return _flash; }
+
+private:
+  uint8_t readCv(uint32_t addr) const final;
+  void writeCv(uint32_t addr, uint8_t byte) final;
+  void eraseZpp() final;
+  void eraseZppRange(uint32_t addr, uint32_t count) final;
+  void copyZpp(uint32_t src, uint32_t dst, uint32_t count) final;
+  uint32_t crc32Zpp(uint32_t addr, uint32_t count) const final;
+#if ZUSI_RX_CHUNK_SIZE
+  void stageZpp(uint32_t addr, std::span<uint8_t const> bytes) final;
+  void commitZpp() final;
+  void discardZpp() final;
+#else
+  void writeZpp(uint32_t addr, std::span<uint8_t const> bytes) final;
+#endif
+  zusi::Features features() const final;
+  zusi::Capabilities capabilities() const final;
+  void exit(uint8_t) final {}
+  bool loadCodeValid(std::span<uint8_t const, 4uz>) const final {
+    return true;
+  }
+  bool addressValid(uint32_t) const final { return true; }
+#if ZUSI_RX_EVENT_LOG_SIZE
+  uint32_t timestamp() const final;
+#endif
+  std::optional<uint8_t> receiveByte() const final;
+  bool waitClock(bool state) const final;
+  void writeData(bool state) const final;
+  void spiSlave() const final {}
+  void gpioOutput() const final {}
+
+  void store(uint32_t addr, std::span<uint8_t const> bytes);
+
+  Lines& _lines;
+  std::array<uint8_t, 1024uz> _cvs{};
+  std::vector<uint8_t> _flash{};
+#if ZUSI_RX_CHUNK_SIZE
+  std::vector<std::pair<uint32_t, std::vector<uint8_t>>> _staged{};
+#endif
+};
+
+// Host talking to a simulated decoder
+//
+// Every wait of the host lets the decoder thread catch up, so the decoder
+// sees the exact sequence of clock edges the host produces. Transmission
+// time is modelled from the bytes and delays instead of being slept.
+class SimulatedBus : public zusi::tx::Base {
+public:
+  SimulatedBus();
+  ~SimulatedBus();
+
+  SimulatedDecoder const& decoder() const { return _decoder; }
+
+  // Modelled bus time
+  std::chrono::nanoseconds busTime() const { return _bus_time; }
+
+private:
+  void transmitBytes(std::span<uint8_t const> bytes,
+                     zusi::Mbps mbps) const final;
+  void spiMaster() const final {}
+  void gpioInput() const final {}
+  void gpioOutput() const final {}
+  void writeClock(bool state) const final;
+  void writeData(bool state) const final;
+  bool readData() const final;
+  void delayUs(uint32_t us) const final;
+  void receiveBytes(std::span<uint8_t> bytes, zusi::Mbps mbps) const final;
+
+  // Wait for decoder to block
+  void settle() const;
+
+  mutable Lines _lines{};
+  mutable std::chrono::nanoseconds _bus_time{};
+  SimulatedDecoder _decoder{_lines};
+  std::jthread _thread;
+};
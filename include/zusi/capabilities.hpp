@@ -0,0 +1,156 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Capabilities
+///
+/// \file   zusi/capabilities.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "features.hpp"
+#include "mbps.hpp"
+#include "utility.hpp"
+
+namespace zusi {
+
+/// Capability bytes used by Command::Capabilities
+///
+/// Contrary to features, a bit is set if a capability is supported and all
+/// reserved bits are cleared. Devices answer with a wired AND, so the host
+/// receives the capabilities common to all devices taking part.
+/// - Byte 0 Commands (ZPP-Write-Burst, ZPP-Write-Compressed, ZPP-CRC32-Query,
+///          fast response phase, ZPP-Erase-Range, ZPP-Write-FEC, ZPP-Copy,
+///          several CVs per CV-Read and CV-Write)
+/// - Byte 1 Timing (0.286Mbps, 1.364Mbps, 1.807Mbps, fast timing)
+/// - Byte 2 Bit n set if bursts of up to 2^(n+1) blocks are supported
+/// - Byte 3 Bit n set if flash pages are no larger than 2^(n+6) bytes
+using CapabilityBytes = std::array<uint8_t, 4uz>;
+
+/// Decoded capabilities
+struct Capabilities {
+  bool zpp_write_burst{};           ///< ZPP-Write-Burst supported
+  bool zpp_write_compressed{};      ///< ZPP-Write-Compressed supported
+  bool zpp_crc32_query{};           ///< ZPP-CRC32-Query supported
+  bool fast_response{};             ///< Fast response phase supported
+  bool zpp_erase_range{};           ///< ZPP-Erase-Range supported
+  bool zpp_write_fec{};             ///< ZPP-Write-FEC supported
+  bool zpp_copy{};                  ///< ZPP-Copy supported
+  bool cv_multiple{};               ///< Several CVs per frame supported
+  Mbps mbps{Mbps::_0_1};            ///< Fastest transmission speed
+  bool fast_timing{};               ///< tx::fast_timing supported
+  size_t zpp_write_burst_blocks{};  ///< Maximum blocks per burst
+  size_t page_size{};               ///< Flash page size (0 if unknown)
+
+  constexpr bool operator==(Capabilities const&) const = default;
+};
+
+/// Capabilities common to two (sets of) devices
+///
+/// \param  lhs           Capabilities
+/// \param  rhs           Capabilities
+/// \return Capabilities  Capabilities supported by both
+constexpr Capabilities operator&(Capabilities const& lhs,
+                                 Capabilities const& rhs) {
+  return {
+    .zpp_write_burst = lhs.zpp_write_burst && rhs.zpp_write_burst,
+    .zpp_write_compressed =
+      lhs.zpp_write_compressed && rhs.zpp_write_compressed,
+    .zpp_crc32_query = lhs.zpp_crc32_query && rhs.zpp_crc32_query,
+    .fast_response = lhs.fast_response && rhs.fast_response,
+    .zpp_erase_range = lhs.zpp_erase_range && rhs.zpp_erase_range,
+    .zpp_write_fec = lhs.zpp_write_fec && rhs.zpp_write_fec,
+    .zpp_copy = lhs.zpp_copy && rhs.zpp_copy,
+    .cv_multiple = lhs.cv_multiple && rhs.cv_multiple,
+    .mbps = std::min(lhs.mbps, rhs.mbps),
+    .fast_timing = lhs.fast_timing && rhs.fast_timing,
+    .zpp_write_burst_blocks =
+      std::min(lhs.zpp_write_burst_blocks, rhs.zpp_write_burst_blocks),
+    .page_size = !lhs.page_size || !rhs.page_size
+                   ? 0uz
+                   : std::max(lhs.page_size, rhs.page_size)};
+}
+
+/// Decode capability bytes
+///
+/// \param  bytes         Capability bytes
+/// \return Capabilities  Decoded capabilities
+constexpr Capabilities data2capabilities(CapabilityBytes const& bytes) {
+  auto const burst{static_cast<bool>(bytes[0uz] & 0b1u)};
+  return {.zpp_write_burst = burst,
+          .zpp_write_compressed = static_cast<bool>(bytes[0uz] & 0b10u),
+          .zpp_crc32_query = static_cast<bool>(bytes[0uz] & 0b100u),
+          .fast_response = static_cast<bool>(bytes[0uz] & 0b1000u),
+          .zpp_erase_range = static_cast<bool>(bytes[0uz] & 0b1'0000u),
+          .zpp_write_fec = static_cast<bool>(bytes[0uz] & 0b10'0000u),
+          .zpp_copy = static_cast<bool>(bytes[0uz] & 0b100'0000u),
+          .cv_multiple = static_cast<bool>(bytes[0uz] & 0b1000'0000u),
+          .mbps = static_cast<Mbps>(std::countr_one(bytes[1uz] & 0b111u)),
+          .fast_timing = static_cast<bool>(bytes[1uz] & 0b1000u),
+          .zpp_write_burst_blocks =
+            burst ? 1uz << std::countr_one(bytes[2uz]) : 0uz,
+          .page_size = bytes[3uz] ? 64uz << std::countr_zero(bytes[3uz])
+                                  : 0uz};
+}
+
+/// Encode capabilities
+///
+/// \param  capabilities    Capabilities
+/// \return CapabilityBytes Capability bytes
+constexpr CapabilityBytes capabilities2data(Capabilities const& capabilities) {
+  CapabilityBytes bytes{};
+  bytes[0uz] = static_cast<uint8_t>((capabilities.zpp_write_burst << 0u) |
+                                    (capabilities.zpp_write_compressed << 1u) |
+                                    (capabilities.zpp_crc32_query << 2u) |
+                                    (capabilities.fast_response << 3u) |
+                                    (capabilities.zpp_erase_range << 4u) |
+                                    (capabilities.zpp_write_fec << 5u) |
+                                    (capabilities.zpp_copy << 6u) |
+                                    (capabilities.cv_multiple << 7u));
+  bytes[1uz] =
+    static_cast<uint8_t>(((1u << std::to_underlying(capabilities.mbps)) - 1u) |
+                         (capabilities.fast_timing << 3u));
+  // Thermometer codes, so that a wired AND yields the common minimum
+  if (capabilities.zpp_write_burst)
+    for (auto n{0uz}; n < CHAR_BIT; ++n)
+      if (capabilities.zpp_write_burst_blocks >= 2uz << n)
+        bytes[2uz] |= static_cast<uint8_t>(1u << n);
+  if (capabilities.page_size)
+    for (auto n{0uz}; n < CHAR_BIT; ++n)
+      if (capabilities.page_size <= 64uz << n)
+        bytes[3uz] |= static_cast<uint8_t>(1u << n);
+  return bytes;
+}
+
+/// Derive capabilities from features
+///
+/// Features have no bit for several CVs per frame, so it is never set.
+///
+/// \param  features      Feature bytes
+/// \return Capabilities  Capabilities
+constexpr Capabilities features2capabilities(Features const& features) {
+  auto const burst{zpp_write_burst_supported(features)};
+  return {.zpp_write_burst = burst,
+          .zpp_write_compressed = zpp_write_compressed_supported(features),
+          .zpp_crc32_query = zpp_crc32_query_supported(features),
+          .fast_response = fast_response_supported(features),
+          .zpp_erase_range = zpp_erase_range_supported(features),
+          .zpp_write_fec = zpp_write_fec_supported(features),
+          .zpp_copy = zpp_copy_supported(features),
+          .mbps = !(features[0uz] & 0b100u)  ? Mbps::_1_807
+                  : !(features[0uz] & 0b010u) ? Mbps::_1_364
+                  : !(features[0uz] & 0b001u) ? Mbps::_0_286
+                                              : Mbps::_0_1,
+          .zpp_write_burst_blocks = burst ? zpp_write_burst_max_blocks : 0uz};
+}
+
+} // namespace zusi
@@ -22,7 +22,14 @@ enum struct Command : uint8_t {
   ZppWrite = 0x05u,
   Features = 0x06u,
   Exit = 0x07u,
-  ZppLcDcQuery = 0x0D
+  ZppWriteBurst = 0x08u,
+  ZppWriteCompressed = 0x09u,
+  ZppCrc32Query = 0x0Au,
+  ZppEraseRange = 0x0Bu,
+  Capabilities = 0x0Cu,
+  ZppLcDcQuery = 0x0Du,
+  ZppWriteFec = 0x0Eu,
+  ZppCopy = 0x0Fu
 };
 
 } // namespace zusi
@@ -0,0 +1,172 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Compression of ZPP data
+///
+/// A compressed block is a sequence of tokens, each starting with a control
+/// byte:
+/// - 0b0LLLLLLL          L+1 literal bytes follow
+/// - 0b10LLLLLL B        Byte B repeated L+3 times
+/// - 0b11LLLLLL O        Copy L+3 bytes starting O+1 bytes back
+///
+/// Copies only reference data of the same block, so decompressing requires no
+/// more RAM than the decompressed block itself.
+///
+/// \file   zusi/compression.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace zusi {
+
+/// Largest block which can be compressed
+inline constexpr size_t compression_window{256uz};
+
+/// Shortest run or copy
+inline constexpr size_t compression_min_length{3uz};
+
+/// Longest run or copy
+inline constexpr size_t compression_max_length{compression_min_length + 63uz};
+
+/// Most literal bytes in a single token
+inline constexpr size_t compression_max_literals{128uz};
+
+/// Compress block
+///
+/// Runs and copies are chosen greedily by their length. Compression fails if
+/// the result does not fit into dst, passing a dst smaller than src therefore
+/// only accepts results which actually save bytes.
+///
+/// \param  src     Block to compress
+/// \param  dst     Destination
+/// \retval size_t  Compressed size
+/// \retval 0       Does not fit into dst
+constexpr size_t compress(std::span<uint8_t const> src,
+                          std::span<uint8_t> dst) {
+  assert(size(src) <= compression_window);
+  size_t o{};
+  auto const emit{[&](uint8_t byte) {
+    if (o >= size(dst)) return false;
+    dst[o++] = byte;
+    return true;
+  }};
+  auto const flush{[&](size_t first, size_t last) {
+    while (first < last) {
+      auto const count{std::min(last - first, compression_max_literals)};
+      if (!emit(static_cast<uint8_t>(count - 1uz))) return false;
+      for (auto i{0uz}; i < count; ++i)
+        if (!emit(src[first++])) return false;
+    }
+    return true;
+  }};
+
+  size_t literals{};
+  for (auto i{0uz}; i < size(src);) {
+    auto const max_length{std::min(size(src) - i, compression_max_length)};
+
+    // Run of the current byte
+    auto run{1uz};
+    while (run < max_length && src[i + run] == src[i]) ++run;
+
+    // Longest copy from earlier data (may overlap current position)
+    size_t copy{}, offset{};
+    for (auto off{1uz}; off <= i; ++off) {
+      auto length{0uz};
+      while (length < max_length && src[i + length - off] == src[i + length])
+        ++length;
+      if (length > copy) {
+        copy = length;
+        offset = off;
+      }
+    }
+
+    if (run >= compression_min_length && run >= copy) {
+      if (!flush(literals, i) ||
+          !emit(static_cast<uint8_t>(0b1000'0000u |
+                                     (run - compression_min_length))) ||
+          !emit(src[i]))
+        return 0uz;
+      literals = i += run;
+    } else if (copy >= compression_min_length) {
+      if (!flush(literals, i) ||
+          !emit(static_cast<uint8_t>(0b1100'0000u |
+                                     (copy - compression_min_length))) ||
+          !emit(static_cast<uint8_t>(offset - 1uz)))
+        return 0uz;
+      literals = i += copy;
+    } else ++i;
+  }
+  return flush(literals, size(src)) ? o : 0uz;
+}
+
+/// Size of decompressed block
+///
+/// Walks the tokens without producing any output. This allows a receiver to
+/// validate a compressed block before actually decompressing it.
+///
+/// \param  src           Compressed block
+/// \retval size_t        Decompressed size
+/// \retval std::nullopt  Malformed or larger than compression_window
+constexpr std::optional<size_t>
+decompressed_size(std::span<uint8_t const> src) {
+  size_t o{};
+  for (auto i{0uz}; i < size(src);) {
+    auto const ctrl{src[i++]};
+    if (!(ctrl & 0b1000'0000u)) {
+      auto const count{ctrl + 1uz};
+      if (i + count > size(src)) return std::nullopt;
+      i += count;
+      o += count;
+    } else {
+      if (i >= size(src)) return std::nullopt;
+      if (ctrl & 0b0100'0000u && src[i] + 1uz > o) return std::nullopt;
+      ++i;
+      o += (ctrl & 0b0011'1111u) + compression_min_length;
+    }
+    if (o > compression_window) return std::nullopt;
+  }
+  return o;
+}
+
+/// Decompress block
+///
+/// \param  src           Compressed block
+/// \param  dst           Destination
+/// \retval size_t        Decompressed size
+/// \retval std::nullopt  Malformed or does not fit into dst
+constexpr std::optional<size_t> decompress(std::span<uint8_t const> src,
+                                           std::span<uint8_t> dst) {
+  size_t o{};
+  for (auto i{0uz}; i < size(src);) {
+    auto const ctrl{src[i++]};
+    if (!(ctrl & 0b1000'0000u)) {
+      auto const count{ctrl + 1uz};
+      if (i + count > size(src) || o + count > size(dst)) return std::nullopt;
+      std::copy_n(&src[i], count, &dst[o]);
+      i += count;
+      o += count;
+      continue;
+    }
+    auto const count{(ctrl & 0b0011'1111u) + compression_min_length};
+    if (i >= size(src) || o + count > size(dst)) return std::nullopt;
+    if (!(ctrl & 0b0100'0000u)) std::fill_n(&dst[o], count, src[i++]);
+    else {
+      auto const offset{src[i++] + 1uz};
+      if (offset > o) return std::nullopt;
+      for (auto j{0uz}; j < count; ++j) dst[o + j] = dst[o + j - offset];
+    }
+    o += count;
+  }
+  return o;
+}
+
+} // namespace zusi
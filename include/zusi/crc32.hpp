@@ -0,0 +1,47 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// CRC32
+///
+/// \file   zusi/crc32.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace zusi {
+
+/// CRC32 lookup table (IEEE 802.3)
+///
+/// The reversed polynomial representations is 0xEDB88320.
+inline constexpr auto crc32_table{[] {
+  std::array<uint32_t, 256uz> table{};
+  for (auto i{0u}; i < size(table); ++i) {
+    auto crc{i};
+    for (auto j{0u}; j < 8u; ++j)
+      crc = crc & 1u ? crc >> 1u ^ 0xEDB8'8320u : crc >> 1u;
+    table[i] = crc;
+  }
+  return table;
+}()};
+
+/// Calculate CRC32 (IEEE 802.3)
+///
+/// Passing the result of a previous call as crc continues the calculation.
+///
+/// \param  bytes Bytes to calculate CRC32 for
+/// \param  crc   CRC32 of preceding bytes
+/// \return CRC32
+constexpr uint32_t crc32(std::span<uint8_t const> bytes, uint32_t crc = 0u) {
+  crc = ~crc;
+  for (auto const byte : bytes)
+    crc = crc32_table[(crc ^ byte) & 0xFFu] ^ crc >> 8u;
+  return ~crc;
+}
+
+} // namespace zusi
@@ -40,13 +40,24 @@ constexpr uint8_t crc8(uint8_t byte) {
 /// The polynomial representations is 0x31.
 ///
 /// \param  bytes Bytes to calculate CRC8 for
+/// \param  crc   Running CRC8 of previous bytes
 /// \return CRC8
-constexpr uint8_t crc8(std::span<uint8_t const> bytes) {
+constexpr uint8_t crc8(std::span<uint8_t const> bytes, uint8_t crc = 0u) {
   return std::accumulate(
-    cbegin(bytes),
-    cend(bytes),
-    static_cast<uint8_t>(0u),
-    [](uint8_t a, uint8_t b) { return crc8(static_cast<uint8_t>(a ^ b)); });
+    cbegin(bytes), cend(bytes), crc, [](uint8_t a, uint8_t b) {
+      return crc8(static_cast<uint8_t>(a ^ b));
+    });
 }
 
+/// Software CRC8 used by the packet builders unless told otherwise
+struct Crc8 {
+  /// Calculate CRC8
+  ///
+  /// \param  bytes Bytes to calculate CRC8 for
+  /// \return CRC8
+  constexpr uint8_t operator()(std::span<uint8_t const> bytes) const {
+    return crc8(bytes);
+  }
+};
+
 } // namespace zusi
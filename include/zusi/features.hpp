@@ -18,4 +18,70 @@ namespace zusi {
 /// Feature bytes used by Command::Features
 using Features = std::array<uint8_t, 4uz>;
 
+/// Check if ZPP-Write-Burst is supported
+///
+/// \param  features  Feature bytes
+/// \retval true      ZPP-Write-Burst supported
+/// \retval false     ZPP-Write-Burst not supported
+constexpr bool zpp_write_burst_supported(Features const& features) {
+  return !(features[1uz] & 0b1u);
+}
+
+/// Check if ZPP-Write-Compressed is supported
+///
+/// \param  features  Feature bytes
+/// \retval true      ZPP-Write-Compressed supported
+/// \retval false     ZPP-Write-Compressed not supported
+constexpr bool zpp_write_compressed_supported(Features const& features) {
+  return !(features[1uz] & 0b10u);
+}
+
+/// Check if ZPP-CRC32-Query is supported
+///
+/// \param  features  Feature bytes
+/// \retval true      ZPP-CRC32-Query supported
+/// \retval false     ZPP-CRC32-Query not supported
+constexpr bool zpp_crc32_query_supported(Features const& features) {
+  return !(features[1uz] & 0b100u);
+}
+
+/// Check if fast response phase is supported
+///
+/// Decoders which support it answer through their SPI slave, which lets the
+/// host read response bytes at the transmission speed.
+///
+/// \param  features  Feature bytes
+/// \retval true      Fast response phase supported
+/// \retval false     Fast response phase not supported
+constexpr bool fast_response_supported(Features const& features) {
+  return !(features[1uz] & 0b1000u);
+}
+
+/// Check if ZPP-Erase-Range is supported
+///
+/// \param  features  Feature bytes
+/// \retval true      ZPP-Erase-Range supported
+/// \retval false     ZPP-Erase-Range not supported
+constexpr bool zpp_erase_range_supported(Features const& features) {
+  return !(features[1uz] & 0b1'0000u);
+}
+
+/// Check if ZPP-Write-FEC is supported
+///
+/// \param  features  Feature bytes
+/// \retval true      ZPP-Write-FEC supported
+/// \retval false     ZPP-Write-FEC not supported
+constexpr bool zpp_write_fec_supported(Features const& features) {
+  return !(features[1uz] & 0b10'0000u);
+}
+
+/// Check if ZPP-Copy is supported
+///
+/// \param  features  Feature bytes
+/// \retval true      ZPP-Copy supported
+/// \retval false     ZPP-Copy not supported
+constexpr bool zpp_copy_supported(Features const& features) {
+  return !(features[1uz] & 0b100'0000u);
+}
+
 } // namespace zusi
@@ -0,0 +1,119 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Forward error correction of ZPP data
+///
+/// Eight Hamming codes run side by side, one per bit of a byte (bit lane).
+/// Protected bytes take all Hamming positions which are no power of two,
+/// parity byte k takes position 2^k. A final byte holds the parity of
+/// everything else, which extends each lane to SECDED. A single bit error per
+/// lane gets corrected, so even a whole corrupted byte can be. Two errors in
+/// the same lane are detected but not corrected.
+///
+/// \file   zusi/fec.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace zusi {
+
+/// Number of Hamming parity bytes
+inline constexpr size_t fec_hamming_size{9uz};
+
+/// Number of parity bytes (Hamming and overall parity)
+inline constexpr size_t fec_parity_size{fec_hamming_size + 1uz};
+
+/// Largest range which can be protected
+inline constexpr size_t fec_max_size{(1uz << fec_hamming_size) - 1uz -
+                                     fec_hamming_size};
+
+/// Parity bytes
+using FecParity = std::array<uint8_t, fec_parity_size>;
+
+namespace detail {
+
+/// Hamming parity of bytes
+///
+/// \param  bytes Bytes
+/// \return Hamming parity bytes followed by parity of bytes
+constexpr FecParity fec_hamming(std::span<uint8_t const> bytes) {
+  assert(size(bytes) <= fec_max_size);
+  FecParity parity{};
+  size_t pos{3uz};
+  for (auto const byte : bytes) {
+    if (std::has_single_bit(pos)) ++pos;
+    for (auto k{0uz}; k < fec_hamming_size; ++k)
+      if (pos & 1uz << k) parity[k] ^= byte;
+    parity.back() ^= byte;
+    ++pos;
+  }
+  return parity;
+}
+
+} // namespace detail
+
+/// Calculate parity bytes
+///
+/// \param  bytes     Bytes to protect
+/// \return FecParity Parity bytes
+constexpr FecParity fec_encode(std::span<uint8_t const> bytes) {
+  auto parity{detail::fec_hamming(bytes)};
+  for (auto k{0uz}; k < fec_hamming_size; ++k) parity.back() ^= parity[k];
+  return parity;
+}
+
+/// Correct bytes in place
+///
+/// Bytes are left untouched if any lane is uncorrectable.
+///
+/// \param  bytes         Protected bytes
+/// \param  parity        Received parity bytes
+/// \retval size_t        Number of corrected bits in bytes
+/// \retval std::nullopt  Uncorrectable
+constexpr std::optional<size_t> fec_decode(std::span<uint8_t> bytes,
+                                           FecParity const& parity) {
+  auto syndrome{detail::fec_hamming(bytes)};
+  for (auto k{0uz}; k < fec_hamming_size; ++k) {
+    syndrome.back() ^= parity[k];
+    syndrome[k] ^= parity[k];
+  }
+  syndrome.back() ^= parity.back();
+
+  // Locate errors of all lanes before touching any byte (index + 1, 0 if none)
+  std::array<size_t, CHAR_BIT> errors{};
+  for (auto b{0uz}; b < CHAR_BIT; ++b) {
+    size_t pos{};
+    for (auto k{0uz}; k < fec_hamming_size; ++k)
+      pos |= static_cast<size_t>(syndrome[k] >> b & 1u) << k;
+    // Even number of errors, none if syndrome is 0 as well
+    if (!(syndrome.back() >> b & 1u)) {
+      if (pos) return std::nullopt;
+      continue;
+    }
+    // Single error in a parity byte
+    if (!pos || std::has_single_bit(pos)) continue;
+    errors[b] = pos - static_cast<size_t>(std::bit_width(pos));
+    if (errors[b] > size(bytes)) return std::nullopt;
+  }
+
+  size_t corrected{};
+  for (auto b{0uz}; b < CHAR_BIT; ++b)
+    if (errors[b]) {
+      bytes[errors[b] - 1uz] ^= static_cast<uint8_t>(1u << b);
+      ++corrected;
+    }
+  return corrected;
+}
+
+} // namespace zusi
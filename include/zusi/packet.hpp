@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <ztl/inplace_vector.hpp>
 
@@ -17,4 +19,8 @@ namespace zusi {
 
 using Packet = ztl::inplace_vector<uint8_t, ZUSI_MAX_PACKET_SIZE>;
 
+/// Packet with a size known at compile time
+template<size_t N>
+using Frame = std::array<uint8_t, N>;
+
 } // namespace zusi
@@ -10,42 +10,65 @@
 
 #pragma once
 
-#include <climits>
-#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <span>
-#include <utility>
-#include "../command.hpp"
-#include "../crc8.hpp"
+#include "../capabilities.hpp"
 #include "../features.hpp"
-#include "../packet.hpp"
-#include "../utility.hpp"
+#include "static_base.hpp"
 
 namespace zusi::rx {
 
 /// Implements the bare necessities for loading sound
-class Base {
+///
+/// Thin adapter which dispatches the callbacks of StaticBase through a vtable.
+class Base : public StaticBase<Base> {
+  friend StaticBase<Base>;
+  friend class Recorder;
+  friend class Replayer;
+
 public:
   /// Dtor
   virtual constexpr ~Base() = default;
 
-  void receive();
-
 private:
+#if ZUSI_RX_CV_READ
   /// Read CV
   ///
   /// \param  addr  CV address
   /// \return CV value
   virtual uint8_t readCv(uint32_t addr) const = 0;
+#endif
 
+#if ZUSI_RX_CV_WRITE
   /// Write CV
   ///
   /// \param  addr  CV address
   /// \param  byte  CV value
   virtual void writeCv(uint32_t addr, uint8_t byte) = 0;
+#endif
 
+#if ZUSI_RX_ZPP_ERASE
   /// Erase ZPP
   virtual void eraseZpp() = 0;
+#endif
+
+#if ZUSI_RX_ZPP_WRITE && ZUSI_RX_CHUNK_SIZE
+  /// Stage ZPP chunk
+  ///
+  /// Chunks are passed while a ZPP-Write frame is still being received and
+  /// must be held back (e.g. in a flash page latch) until they get committed.
+  ///
+  /// \param  addr  Address
+  /// \param  bytes Bytes
+  virtual void stageZpp(uint32_t addr, std::span<uint8_t const> bytes) = 0;
 
+  /// Commit staged ZPP chunks
+  virtual void commitZpp() = 0;
+
+  /// Discard staged ZPP chunks
+  virtual void discardZpp() = 0;
+#elif ZUSI_RX_ZPP_WRITE
   /// Write ZPP
   ///
   /// \param  addr  Address
@@ -53,17 +76,74 @@ private:
   /// \retval true  Success
   /// \retval false Error
   virtual void writeZpp(uint32_t addr, std::span<uint8_t const> bytes) = 0;
+#endif
+
+#if ZUSI_RX_ZPP_ERASE_RANGE
+  /// Erase ZPP range
+  ///
+  /// Only decoders which advertise ZPP-Erase-Range in their features have to
+  /// override this, the command gets NAKed otherwise.
+  ///
+  /// \param  addr    First address
+  /// \param  size    Number of bytes
+  virtual void eraseZppRange(uint32_t addr, uint32_t size) {
+    StaticBase::eraseZppRange(addr, size);
+  }
+#endif
+
+#if ZUSI_RX_ZPP_COPY
+  /// Copy ZPP range
+  ///
+  /// Only decoders which advertise ZPP-Copy in their features have to override
+  /// this, the command gets NAKed otherwise. The source range has been written
+  /// before and never overlaps the destination range.
+  ///
+  /// \param  src     First source address
+  /// \param  dst     First destination address
+  /// \param  size    Number of bytes
+  virtual void copyZpp(uint32_t src, uint32_t dst, uint32_t size) {
+    StaticBase::copyZpp(src, dst, size);
+  }
+#endif
+
+#if ZUSI_RX_ZPP_CRC32_QUERY
+  /// Calculate CRC32 of ZPP range
+  ///
+  /// Only decoders which advertise ZPP-CRC32-Query in their features have to
+  /// override this, the command gets NAKed otherwise.
+  ///
+  /// \param  addr    First address
+  /// \param  size    Number of bytes
+  /// \return CRC32 of range
+  virtual uint32_t crc32Zpp(uint32_t addr, uint32_t size) const {
+    return StaticBase::crc32Zpp(addr, size);
+  }
+#endif
 
   /// Get features
   ///
   /// \return Features
   virtual Features features() const = 0;
 
+#if ZUSI_RX_CAPABILITIES
+  /// Get capabilities
+  ///
+  /// Decoders which want to advertise more than their features (e.g. fast
+  /// timing, burst size or page size) have to override this. Several CVs per
+  /// frame are advertised as long as the receive buffer holds 256 of them.
+  ///
+  /// \return Capabilities
+  virtual Capabilities capabilities() const {
+    return StaticBase::capabilities();
+  }
+#endif
+
   /// Exit
   ///
   /// \param  flags Flags
   virtual void exit(uint8_t flags) = 0;
 
+#if ZUSI_RX_ZPP_LC_DC_QUERY
   /// Check if load code is valid
   ///
   /// \param  developer_code  Developer code
@@ -71,13 +151,23 @@ private:
   /// \retval false           Load code is not valid
   virtual bool
   loadCodeValid(std::span<uint8_t const, 4uz> developer_code) const = 0;
+#endif
 
+#if ZUSI_RX_ZPP_ADDRESS
   /// Check if address is valid
   ///
   /// \param  addr  Address
   /// \retval true  Address valid
   /// \retval false Address not valid
   virtual bool addressValid(uint32_t addr) const = 0;
+#endif
+
+#if ZUSI_RX_EVENT_LOG_SIZE
+  /// Get timestamp of event log
+  ///
+  /// \return Free running counter (e.g. cycle counter)
+  virtual uint32_t timestamp() const = 0;
+#endif
 
   /// Receive byte
   ///
@@ -103,36 +193,35 @@ private:
   /// Switch to GPIO output
   virtual void gpioOutput() const = 0;
 
+  /// Transmit bytes of response phase
+  ///
+  /// Only decoders which advertise the fast response phase in their features
+  /// have to override this (e.g. with bidirectional SPI).
+  ///
+  /// \param  bytes Bytes to transmit
+  /// \retval true  Success
+  /// \retval false Timeout occurred
+  virtual bool transmitBytes(std::span<uint8_t const> bytes) const {
+    return StaticBase::transmitBytes(bytes);
+  }
+
   /// Toggle front- and rear lights
   virtual void toggleLights() const {}
 
-  enum struct State : uint8_t {
-    ReceiveCommand,
-    ReceiveData,
-    ReceiveResync,
-    TransmitAck,
-    TransmitBusy,
-    TransmitData,
-    Error
-  };
-
-  State receiveCommand();
-  State receiveData();
-  State receiveResync();
-  State transmitAck();
-  State transmitBusy();
-  State transmitData();
-
-  State execute(Command cmd);
-  State reset();
-  bool receiveBytes(size_t count);
-  bool transmitByte(uint8_t byte) const;
-  bool ackOrNack();
-
-  Packet _packet{}; ///< Receive/transmit
-  uint8_t _crc{};   ///< CRC8
-  State _state{};   ///< State
-  bool _ack{};      ///< Ack/nak
+  /// Accumulate CRC8 of bytes
+  ///
+  /// Decoders with a CRC unit configured for polynomial 0x31 may override
+  /// this, it must return the same results as crc8.
+  ///
+  /// \param  bytes Bytes to accumulate
+  /// \param  crc   Running CRC8 of previous bytes
+  /// \return CRC8
+  virtual uint8_t accumulateCrc8(std::span<uint8_t const> bytes,
+                                 uint8_t crc) const {
+    return StaticBase::accumulateCrc8(bytes, crc);
+  }
 };
 
+extern template class StaticBase<Base>;
+
 } // namespace zusi::rx
@@ -0,0 +1,100 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Commands compiled into rx::Base
+///
+/// Bit n of ZUSI_RX_COMMANDS enables the command with code n. Disabled commands
+/// are answered like unknown ones, their code paths and callbacks are not
+/// compiled and the receive buffer only gets as large as the largest enabled
+/// frame. Features and Exit are always enabled.
+///
+/// \file   zusi/rx/commands.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "../command.hpp"
+#include "../utility.hpp"
+
+/// Check if command code is enabled
+#define ZUSI_RX_COMMAND(code) (((ZUSI_RX_COMMANDS) >> (code) & 1u) != 0u)
+
+// Callbacks required by enabled commands
+#define ZUSI_RX_CV_READ ZUSI_RX_COMMAND(0x01u)
+#define ZUSI_RX_CV_WRITE ZUSI_RX_COMMAND(0x02u)
+#define ZUSI_RX_ZPP_ERASE_RANGE ZUSI_RX_COMMAND(0x0Bu)
+#define ZUSI_RX_ZPP_ERASE (ZUSI_RX_COMMAND(0x04u) || ZUSI_RX_ZPP_ERASE_RANGE)
+#define ZUSI_RX_ZPP_WRITE                                                      \
+  (ZUSI_RX_COMMAND(0x05u) || ZUSI_RX_COMMAND(0x08u) ||                         \
+   (!ZUSI_RX_CHUNK_SIZE && (ZUSI_RX_COMMAND(0x09u) || ZUSI_RX_COMMAND(0x0Eu))))
+#define ZUSI_RX_ZPP_CRC32_QUERY ZUSI_RX_COMMAND(0x0Au)
+#define ZUSI_RX_CAPABILITIES ZUSI_RX_COMMAND(0x0Cu)
+#define ZUSI_RX_ZPP_LC_DC_QUERY ZUSI_RX_COMMAND(0x0Du)
+#define ZUSI_RX_ZPP_COPY ZUSI_RX_COMMAND(0x0Fu)
+#define ZUSI_RX_ZPP_ADDRESS                                                    \
+  (ZUSI_RX_ZPP_WRITE || ZUSI_RX_ZPP_ERASE_RANGE || ZUSI_RX_ZPP_COPY)
+
+namespace zusi::rx {
+
+/// Mask of commands compiled into rx::Base
+inline constexpr uint32_t enabled_commands{ZUSI_RX_COMMANDS};
+
+/// Check if command is enabled
+///
+/// \param  cmd       Command
+/// \param  commands  Command mask
+/// \retval true      Command enabled
+/// \retval false     Command disabled
+constexpr bool is_enabled_command(Command cmd,
+                                  uint32_t commands = enabled_commands) {
+  if (cmd == Command::Features || cmd == Command::Exit) return true;
+  // Decompressing and correcting require the whole block
+  if (ZUSI_RX_CHUNK_SIZE &&
+      (cmd == Command::ZppWriteCompressed || cmd == Command::ZppWriteFec))
+    return false;
+  return commands >> std::to_underlying(cmd) & 1u;
+}
+
+/// Size of the largest frame (or response) of the enabled commands
+///
+/// ZPP data beyond a chunk gets passed on while it is received. CV-Write is
+/// only sized for a single CV, frames with more CVs than fit get skipped and
+/// NAKed.
+///
+/// \param  commands  Command mask
+/// \return Size in bytes
+constexpr size_t max_packet_size(uint32_t commands) {
+  constexpr auto zpp_write_size{
+    data_pos + (ZUSI_RX_CHUNK_SIZE ? ZUSI_RX_CHUNK_SIZE : 256uz) + 1uz};
+  constexpr std::pair<Command, size_t> sizes[]{
+    {Command::CvRead, 7uz},
+    {Command::CvWrite, data_pos + 2uz},
+    {Command::ZppErase, 4uz},
+    {Command::ZppWrite, zpp_write_size},
+    {Command::Features, 4uz},
+    {Command::Exit, 5uz},
+    {Command::ZppWriteBurst, zpp_write_size},
+    {Command::ZppWriteCompressed, data_pos + 256uz + 1uz},
+    {Command::ZppCrc32Query, 10uz},
+    {Command::ZppEraseRange, 12uz},
+    {Command::Capabilities, 8uz},
+    {Command::ZppLcDcQuery, 6uz},
+    {Command::ZppWriteFec, data_pos + 256uz + 1uz},
+    {Command::ZppCopy, 14uz},
+  };
+  size_t retval{};
+  for (auto const& [cmd, size] : sizes)
+    if (is_enabled_command(cmd, commands)) retval = std::max(retval, size);
+  return std::min<size_t>(retval, ZUSI_MAX_PACKET_SIZE);
+}
+
+/// Size of the receive buffer of rx::Base
+inline constexpr size_t packet_size{max_packet_size(enabled_commands)};
+
+} // namespace zusi::rx
@@ -0,0 +1,83 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Entry sequence detector
+///
+/// \file   zusi/rx/entry_detector.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../utility.hpp"
+
+namespace zusi::rx {
+
+/// Detected entry sequence
+enum struct Entry : uint8_t {
+  None,    ///< Nothing detected (yet)
+  Regular, ///< Entry sequence (10ms clock)
+  Fast,    ///< Fast entry sequence (1ms clock)
+};
+
+/// Detects entry sequences while a device is in normal operation
+///
+/// Has to be fed with the state of the data line on every falling clock edge
+/// (e.g. from a pin change interrupt). A sequence gets detected once half of
+/// its periods have been seen with alternating data and a clock period within
+/// half and twice its nominal value, so detection may start late.
+class EntryDetector {
+public:
+  /// Number of periods required to detect the entry sequence
+  static constexpr size_t regular_periods{entry_periods / 2uz};
+
+  /// Number of periods required to detect the fast entry sequence
+  static constexpr size_t fast_periods{fast_entry_periods / 2uz};
+
+  /// Feed falling clock edge
+  ///
+  /// \param  data    State of data line
+  /// \param  time_us Timestamp in µs
+  /// \return Entry   Detected entry sequence, reported once
+  constexpr Entry fallingEdge(bool data, uint32_t time_us) {
+    auto const period{time_us - _time_us};
+    auto const entry{classify(period)};
+    if (entry == Entry::None || entry != _entry || data == _data) _count = 0uz;
+    _entry = entry;
+    _data = data;
+    _time_us = time_us;
+    if (entry == Entry::None) return Entry::None;
+    ++_count;
+    if (_count < (entry == Entry::Fast ? fast_periods : regular_periods))
+      return Entry::None;
+    reset();
+    return entry;
+  }
+
+  /// Reset
+  constexpr void reset() { *this = {}; }
+
+private:
+  /// Classify clock period
+  ///
+  /// \param  period  Clock period in µs
+  /// \return Entry   Entry sequence the period belongs to
+  static constexpr Entry classify(uint32_t period) {
+    if (period >= fast_entry_period_us / 2u &&
+        period <= fast_entry_period_us * 2u)
+      return Entry::Fast;
+    else if (period >= entry_period_us / 2u && period <= entry_period_us * 2u)
+      return Entry::Regular;
+    else return Entry::None;
+  }
+
+  size_t _count{};
+  uint32_t _time_us{};
+  Entry _entry{};
+  bool _data{};
+};
+
+} // namespace zusi::rx
@@ -0,0 +1,161 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Receive event log
+///
+/// \file   zusi/rx/event_log.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace zusi::rx {
+
+/// Number of states of the receive state machine
+inline constexpr uint32_t event_log_states{7u};
+
+/// Cause of a transition
+enum struct Cause : uint8_t {
+  None,           ///< Regular transition
+  Timeout,        ///< receiveByte or waitClock timed out
+  InvalidCommand, ///< Unknown command byte
+  CrcError,       ///< CRC mismatch
+  Nak,            ///< Not acknowledged (e.g. invalid address or safety bytes)
+  NoResync,       ///< Byte after packet was not a resync byte
+};
+
+/// Number of causes
+inline constexpr uint32_t event_log_causes{
+  std::to_underlying(Cause::NoResync) + 1u};
+
+/// First CV address of the event log
+///
+/// The log can be read back with CV-Read starting at this address. All words
+/// are big endian.
+/// - 4 byte   Number of recorded events
+/// - 7x4 byte Number of transitions into each state
+/// - 7x4 byte Timestamp ticks spent in each state
+/// - 6x4 byte Number of transitions by cause
+/// - Nx8 byte Ring of events (timestamp, from, to, cause, 0), the oldest one
+///            at number of recorded events modulo N once wrapped
+inline constexpr uint32_t event_log_cv{0xFFFF'0000u};
+
+/// Single state transition
+struct Transition {
+  uint32_t time{}; ///< Timestamp
+  uint8_t from{};  ///< Previous state
+  uint8_t to{};    ///< Next state
+  Cause cause{};   ///< Cause
+};
+
+/// Ring of state transitions and aggregated counters
+///
+/// Recording never blocks and only takes a handful of instructions, the
+/// oldest events get overwritten. Counters aggregate over the whole lifetime.
+///
+/// \tparam N Number of events, must be a power of two
+template<size_t N>
+class EventLog {
+  static_assert(std::has_single_bit(N), "N must be a power of two");
+
+public:
+  /// Size of log in CVs
+  static constexpr uint32_t cv_count{
+    (1u + 2u * event_log_states + event_log_causes) * 4u + N * 8u};
+
+  /// Record transition
+  ///
+  /// \param  time  Timestamp
+  /// \param  from  Previous state
+  /// \param  to    Next state
+  /// \param  cause Cause
+  constexpr void
+  record(uint32_t time, uint8_t from, uint8_t to, Cause cause = {}) {
+    _events[_count % N] = {time, from, to, cause};
+    ++_count;
+    _ticks[from] += time - _last;
+    _last = time;
+    ++_entries[to];
+    ++_errors[std::to_underlying(cause)];
+  }
+
+  /// Number of recorded events
+  ///
+  /// \return Number of recorded events
+  constexpr uint32_t count() const { return _count; }
+
+  /// Recorded transition
+  ///
+  /// \param  i           Index, 0 being the oldest event still in the ring
+  /// \return Transition
+  constexpr Transition const& operator[](size_t i) const {
+    return _events[(_count > N ? _count - N + i : i) % N];
+  }
+
+  /// Number of transitions into state
+  ///
+  /// \param  state State
+  /// \return Number of transitions
+  constexpr uint32_t entries(uint8_t state) const { return _entries[state]; }
+
+  /// Timestamp ticks spent in state
+  ///
+  /// \param  state State
+  /// \return Ticks
+  constexpr uint32_t ticks(uint8_t state) const { return _ticks[state]; }
+
+  /// Number of transitions with cause
+  ///
+  /// \param  cause Cause
+  /// \return Number of transitions
+  constexpr uint32_t errors(Cause cause) const {
+    return _errors[std::to_underlying(cause)];
+  }
+
+  /// Read log as CV
+  ///
+  /// \param  offset  Offset from event_log_cv
+  /// \return CV value
+  constexpr uint8_t cv(uint32_t offset) const {
+    auto const byte{[](uint32_t word, uint32_t i) {
+      return static_cast<uint8_t>(word >> (24u - 8u * (i % 4u)));
+    }};
+    if (offset < 4u) return byte(_count, offset);
+    offset -= 4u;
+    if (offset < event_log_states * 4u)
+      return byte(_entries[offset / 4u], offset);
+    offset -= event_log_states * 4u;
+    if (offset < event_log_states * 4u)
+      return byte(_ticks[offset / 4u], offset);
+    offset -= event_log_states * 4u;
+    if (offset < event_log_causes * 4u)
+      return byte(_errors[offset / 4u], offset);
+    offset -= event_log_causes * 4u;
+    if (offset >= N * 8u) return 0u;
+    auto const& event{_events[offset / 8u]};
+    switch (offset % 8u) {
+      case 4u: return event.from;
+      case 5u: return event.to;
+      case 6u: return std::to_underlying(event.cause);
+      case 7u: return 0u;
+      default: return byte(event.time, offset);
+    }
+  }
+
+private:
+  std::array<Transition, N> _events{};
+  std::array<uint32_t, event_log_states> _entries{};
+  std::array<uint32_t, event_log_states> _ticks{};
+  std::array<uint32_t, event_log_causes> _errors{};
+  uint32_t _count{};
+  uint32_t _last{};
+};
+
+} // namespace zusi::rx
@@ -0,0 +1,815 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Statically dispatched receive base
+///
+/// \file   zusi/rx/static_base.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/util>
+#include <optional>
+#include <span>
+#include <ztl/inplace_vector.hpp>
+#include "../capabilities.hpp"
+#include "../command.hpp"
+#include "../compression.hpp"
+#include "../crc8.hpp"
+#include "../features.hpp"
+#include "../fec.hpp"
+#include "../packet.hpp"
+#include "../utility.hpp"
+#include "commands.hpp"
+#include "event_log.hpp"
+
+namespace zusi::rx {
+
+/// Receive state machine on top of statically dispatched callbacks
+///
+/// Impl must derive from StaticBase<Impl> and provide the callbacks and
+/// hardware access functions of rx::Base as well as optionally eraseZppRange,
+/// copyZpp, crc32Zpp, capabilities, transmitBytes, toggleLights and
+/// accumulateCrc8. Callbacks of commands disabled by ZUSI_RX_COMMANDS are not
+/// required.
+/// The functions may be private if StaticBase<Impl> is declared friend. Since
+/// no call goes through a vtable, the per-bit loops can be inlined entirely.
+///
+/// \tparam Impl  Implementation type
+template<typename Impl>
+class StaticBase {
+public:
+  void receive();
+
+#if ZUSI_RX_EVENT_LOG_SIZE
+  /// Get event log
+  ///
+  /// \return Event log
+  constexpr EventLog<ZUSI_RX_EVENT_LOG_SIZE> const& eventLog() const {
+    return _log;
+  }
+#endif
+
+protected:
+  /// Dtor
+  constexpr ~StaticBase() {
+    static_assert(
+      requires(Impl& impl,
+               Impl const& cimpl,
+               uint32_t addr,
+               uint8_t byte,
+               std::span<uint8_t const> bytes,
+               std::span<uint8_t const, 4uz> developer_code,
+               bool state) {
+#if ZUSI_RX_CV_READ
+        { cimpl.readCv(addr) } -> std::convertible_to<uint8_t>;
+#endif
+#if ZUSI_RX_CV_WRITE
+        impl.writeCv(addr, byte);
+#endif
+#if ZUSI_RX_ZPP_ERASE
+        impl.eraseZpp();
+#endif
+#if ZUSI_RX_ZPP_ERASE_RANGE
+        impl.eraseZppRange(addr, addr);
+#endif
+#if ZUSI_RX_ZPP_COPY
+        impl.copyZpp(addr, addr, addr);
+#endif
+#if ZUSI_RX_ZPP_WRITE && ZUSI_RX_CHUNK_SIZE
+        impl.stageZpp(addr, bytes);
+        impl.commitZpp();
+        impl.discardZpp();
+#elif ZUSI_RX_ZPP_WRITE
+        impl.writeZpp(addr, bytes);
+#endif
+#if ZUSI_RX_ZPP_CRC32_QUERY
+        { cimpl.crc32Zpp(addr, addr) } -> std::convertible_to<uint32_t>;
+#endif
+        { cimpl.features() } -> std::convertible_to<Features>;
+#if ZUSI_RX_CAPABILITIES
+        { cimpl.capabilities() } -> std::convertible_to<Capabilities>;
+#endif
+        impl.exit(byte);
+#if ZUSI_RX_ZPP_LC_DC_QUERY
+        { cimpl.loadCodeValid(developer_code) } -> std::convertible_to<bool>;
+#endif
+#if ZUSI_RX_ZPP_ADDRESS
+        { cimpl.addressValid(addr) } -> std::convertible_to<bool>;
+#endif
+#if ZUSI_RX_EVENT_LOG_SIZE
+        { cimpl.timestamp() } -> std::convertible_to<uint32_t>;
+#endif
+        {
+          cimpl.receiveByte()
+        } -> std::convertible_to<std::optional<uint8_t>>;
+        { cimpl.waitClock(state) } -> std::convertible_to<bool>;
+        cimpl.writeData(state);
+        cimpl.spiSlave();
+        cimpl.gpioOutput();
+        { cimpl.transmitBytes(bytes) } -> std::convertible_to<bool>;
+        cimpl.toggleLights();
+        { cimpl.accumulateCrc8(bytes, byte) } -> std::convertible_to<uint8_t>;
+      },
+      "Impl does not provide (accessible) callbacks");
+  }
+
+  /// Erase ZPP range
+  ///
+  /// \note
+  /// Default implementation has no access to flash and does nothing, which is
+  /// fine since ZPP-Erase-Range gets NAKed unless features advertise it
+  void eraseZppRange(uint32_t, uint32_t) {}
+
+  /// Copy ZPP range
+  ///
+  /// \note
+  /// Default implementation has no access to flash and does nothing, which is
+  /// fine since ZPP-Copy gets NAKed unless features advertise it
+  void copyZpp(uint32_t, uint32_t, uint32_t) {}
+
+  /// Calculate CRC32 of ZPP range
+  ///
+  /// \note
+  /// Default implementation has no access to flash and always returns 0,
+  /// which is fine since ZPP-CRC32-Query gets NAKed unless features advertise
+  /// it
+  ///
+  /// \return 0
+  uint32_t crc32Zpp(uint32_t, uint32_t) const { return 0u; }
+
+  /// Get capabilities
+  ///
+  /// \note
+  /// Default implementation derives capabilities from features and
+  /// advertises several CVs per frame if 256 of them fit into the receive
+  /// buffer
+  ///
+  /// \return Capabilities
+  Capabilities capabilities() const {
+    auto caps{features2capabilities(impl().features())};
+    caps.cv_multiple = packet_size >= data_pos + 256uz + 1uz;
+    return caps;
+  }
+
+  /// Transmit bytes of response phase
+  ///
+  /// \note
+  /// Default implementation writes every bit on the asynchronous clock
+  ///
+  /// \param  bytes Bytes to transmit
+  /// \retval true  Success
+  /// \retval false Timeout occurred
+  bool transmitBytes(std::span<uint8_t const> bytes) const;
+
+  /// Toggle front- and rear lights
+  void toggleLights() const {}
+
+  /// Accumulate CRC8 of bytes
+  ///
+  /// Allows a CRC unit configured for polynomial 0x31 (reflected, no final
+  /// XOR) to check received packets and to frame responses. Received bytes are
+  /// passed in blocks (e.g. a whole ZPP-Write) so that they can be fed by DMA.
+  ///
+  /// \note
+  /// Default implementation calculates CRC8 in software
+  ///
+  /// \param  bytes Bytes to accumulate
+  /// \param  crc   Running CRC8 of previous bytes
+  /// \return CRC8
+  uint8_t accumulateCrc8(std::span<uint8_t const> bytes, uint8_t crc) const {
+    return crc8(bytes, crc);
+  }
+
+private:
+  /// Implementation
+  ///
+  /// \return Implementation
+  constexpr Impl& impl() { return static_cast<Impl&>(*this); }
+
+  /// Implementation
+  ///
+  /// \return Implementation
+  constexpr Impl const& impl() const {
+    return static_cast<Impl const&>(*this);
+  }
+
+  enum struct State : uint8_t {
+    ReceiveCommand,
+    ReceiveData,
+    ReceiveResync,
+    TransmitAck,
+    TransmitBusy,
+    TransmitData,
+    Error
+  };
+  static_assert(std::to_underlying(State::Error) + 1uz == event_log_states);
+
+  State receiveCommand();
+  State receiveData();
+  State receiveResync();
+  State transmitAck();
+  State transmitBusy();
+  State transmitData();
+
+  State execute(Command cmd);
+  State reset();
+  void note(Cause cause);
+  State error(Cause cause);
+  bool receiveBytes(size_t count);
+  bool skipBytes(size_t count);
+#if ZUSI_RX_CHUNK_SIZE
+  bool receiveChunks(uint32_t addr, size_t count)
+    requires(ZUSI_RX_ZPP_WRITE);
+#else
+  bool receiveParity()
+    requires(is_enabled_command(Command::ZppWriteFec));
+#endif
+  bool receiveBurst()
+    requires(is_enabled_command(Command::ZppWriteBurst));
+  bool transmitByte(uint8_t byte) const;
+  bool ackOrNack();
+
+  /// Receive/transmit, large enough for the largest enabled frame
+  ztl::inplace_vector<uint8_t, packet_size> _packet{};
+#if ZUSI_RX_CHUNK_SIZE
+  bool _staged{}; ///< ZPP chunks staged
+#endif
+  uint8_t _crc{}; ///< CRC8
+  State _state{}; ///< State
+  bool _ack{};    ///< Ack/nak
+  bool _burst{};  ///< All blocks of ZPP-Write-Burst valid
+#if ZUSI_RX_EVENT_LOG_SIZE
+  EventLog<ZUSI_RX_EVENT_LOG_SIZE> _log{}; ///< Event log
+  Cause _cause{};                          ///< Cause of next transition
+#endif
+};
+
+/// Receive
+template<typename Impl>
+void StaticBase<Impl>::receive() {
+#if ZUSI_RX_EVENT_LOG_SIZE
+  auto const state{_state};
+#endif
+  switch (_state) {
+    case State::ReceiveCommand:
+      impl().toggleLights();
+      _state = receiveCommand();
+      break;
+    case State::ReceiveData: _state = receiveData(); break;
+    case State::ReceiveResync: _state = receiveResync(); break;
+    case State::TransmitAck: _state = transmitAck(); break;
+    case State::TransmitBusy: _state = transmitBusy(); break;
+    case State::TransmitData: _state = transmitData(); break;
+    case State::Error: _state = reset(); break;
+  }
+#if ZUSI_RX_EVENT_LOG_SIZE
+  if (_state == state) return;
+  // Timeouts while waiting for a command leave the packet empty and are not
+  // worth recording
+  if (!empty(_packet))
+    _log.record(impl().timestamp(),
+                std::to_underlying(state),
+                std::to_underlying(_state),
+                _state == State::Error ? _cause : Cause::None);
+  if (_state == State::Error) _cause = {};
+#endif
+}
+
+/// Receive command
+///
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::receiveCommand() {
+  _packet.clear();
+  if (!receiveBytes(1uz)) return error(Cause::Timeout);
+  return is_valid_command(_packet[0uz]) &&
+             is_enabled_command(static_cast<Command>(_packet[0uz]))
+           ? State::ReceiveData
+           : error(Cause::InvalidCommand);
+}
+
+/// Receive data
+///
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::receiveData() {
+  bool success{};
+  switch (static_cast<Command>(_packet[0uz])) {
+    case Command::CvRead: success = receiveBytes(6uz); break;
+    case Command::CvWrite:
+      // More CVs than the buffer can hold get skipped and NAKed
+      if ((success = receiveBytes(1uz))) {
+        auto const count{_packet[1uz] + 6uz};
+        success = size(_packet) + count <= _packet.capacity()
+                    ? receiveBytes(count)
+                    : skipBytes(count);
+      }
+      break;
+    case Command::ZppWrite:
+#if ZUSI_RX_CHUNK_SIZE
+      if constexpr (is_enabled_command(Command::ZppWrite))
+        if ((success = receiveBytes(5uz)))
+          success = receiveChunks(data2uint32(&_packet[addr_pos]),
+                                  _packet[1uz] + 1uz);
+#else
+      if ((success = receiveBytes(1uz)))
+        success = receiveBytes(_packet[1uz] + 6uz);
+#endif
+      break;
+    case Command::ZppErase: success = receiveBytes(3uz); break;
+    case Command::ZppWriteBurst:
+      if constexpr (is_enabled_command(Command::ZppWriteBurst)) {
+        // Header is useless without valid count
+        if (!receiveBytes(6uz)) return error(Cause::Timeout);
+        if (_crc) return error(Cause::CrcError);
+        success = receiveBurst();
+      }
+      break;
+#if !ZUSI_RX_CHUNK_SIZE
+    // Decompressing requires the whole block
+    case Command::ZppWriteCompressed:
+      if ((success = receiveBytes(1uz)))
+        success = receiveBytes(_packet[1uz] + 6uz);
+      break;
+    // Correcting requires the whole block
+    case Command::ZppWriteFec:
+      if constexpr (is_enabled_command(Command::ZppWriteFec))
+        if ((success = receiveBytes(1uz)))
+          success = receiveBytes(_packet[1uz] + 6uz) && receiveParity();
+      break;
+#endif
+    case Command::ZppCrc32Query: success = receiveBytes(9uz); break;
+    case Command::ZppEraseRange: success = receiveBytes(11uz); break;
+    case Command::ZppCopy: success = receiveBytes(13uz); break;
+    case Command::Features: success = receiveBytes(1uz); break;
+    case Command::Capabilities: success = receiveBytes(2uz); break;
+    case Command::Exit: success = receiveBytes(4uz); break;
+    case Command::ZppLcDcQuery: success = receiveBytes(5uz); break;
+    default: return error(Cause::InvalidCommand);
+  }
+  return success ? State::ReceiveResync : error(Cause::Timeout);
+}
+
+/// Receive resync byte
+///
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::receiveResync() {
+  auto const crc{_crc};
+  _ack = ackOrNack();
+  if (!_ack) note(crc ? Cause::CrcError : Cause::Nak);
+  if (auto const retval{impl().receiveByte()}; !retval)
+    return error(Cause::Timeout);
+  else if (*retval == resync_byte) {
+    impl().gpioOutput();
+    return State::TransmitAck;
+  } else return error(Cause::NoResync);
+}
+
+/// Transmit acknowledge
+///
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::transmitAck() {
+  if (!impl().waitClock(true)) return error(Cause::Timeout);
+  impl().writeData(false);
+  if (!impl().waitClock(false)) return error(Cause::Timeout);
+  if (!impl().waitClock(true)) return error(Cause::Timeout);
+  if (_ack == true) impl().writeData(true);
+  if (!impl().waitClock(false)) return error(Cause::Timeout);
+  return _ack == true ? State::TransmitBusy : State::Error;
+}
+
+/// Transmit busy
+///
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::transmitBusy() {
+  auto const cmd{static_cast<Command>(_packet[0uz])};
+  /// \todo MXULF did not clock busy prior to <=0.84.112
+  if (cmd != Command::Exit && !impl().waitClock(true))
+    return error(Cause::Timeout);
+  /// \note Don't pull low if exiting anyhow
+  if (cmd != Command::Exit) impl().writeData(false);
+  auto const retval{execute(cmd)};
+  if (!impl().waitClock(false)) return error(Cause::Timeout);
+  impl().writeData(true);
+  if (retval == State::ReceiveCommand) impl().spiSlave();
+  return retval;
+}
+
+/// Transmit data
+///
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::transmitData() {
+  if (!impl().transmitBytes({cbegin(_packet), size(_packet)}))
+    return error(Cause::Timeout);
+  return reset();
+}
+
+/// Execute command
+///
+/// \param  cmd Command
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::execute(Command cmd) {
+  State retval{State::ReceiveCommand};
+  uint32_t const addr{data2uint32(&_packet[2uz])};
+  switch (cmd) {
+    case Command::CvRead:
+      if constexpr (is_enabled_command(Command::CvRead)) {
+        size_t const count{_packet[1uz] + 1uz};
+        _packet.resize(count + 1uz);
+        for (auto i{0uz}; i < count; ++i) {
+          auto const cv_addr{static_cast<uint32_t>(addr + i)};
+#if ZUSI_RX_EVENT_LOG_SIZE
+          _packet[i] = cv_addr - event_log_cv < _log.cv_count
+                         ? _log.cv(cv_addr - event_log_cv)
+                         : impl().readCv(cv_addr);
+#else
+          _packet[i] = impl().readCv(cv_addr);
+#endif
+        }
+        _packet[count] = impl().accumulateCrc8({cbegin(_packet), count}, 0u);
+        retval = State::TransmitData;
+      }
+      break;
+    case Command::CvWrite:
+      if constexpr (is_enabled_command(Command::CvWrite)) {
+        size_t const count{_packet[1uz] + 1uz};
+        for (auto i{0uz}; i < count; ++i)
+          impl().writeCv(static_cast<uint32_t>(addr + i), _packet[6uz + i]);
+      }
+      break;
+    case Command::ZppErase:
+      if constexpr (is_enabled_command(Command::ZppErase)) impl().eraseZpp();
+      break;
+    case Command::ZppEraseRange:
+      if constexpr (is_enabled_command(Command::ZppEraseRange))
+        impl().eraseZppRange(data2uint32(&_packet[3uz]),
+                             data2uint32(&_packet[7uz]));
+      break;
+    case Command::ZppCopy:
+      if constexpr (is_enabled_command(Command::ZppCopy))
+        impl().copyZpp(data2uint32(&_packet[1uz]),
+                       data2uint32(&_packet[5uz]),
+                       data2uint32(&_packet[9uz]));
+      break;
+#if !ZUSI_RX_CHUNK_SIZE
+    case Command::ZppWriteFec:
+      if constexpr (is_enabled_command(Command::ZppWriteFec))
+        impl().writeZpp(addr, {&_packet[6uz], _packet[1uz] + 1uz});
+      break;
+#endif
+    case Command::ZppWrite:
+      if constexpr (is_enabled_command(Command::ZppWrite)) {
+#if ZUSI_RX_CHUNK_SIZE
+        impl().commitZpp();
+        _staged = false;
+#else
+        size_t const count{_packet[1uz] + 1uz};
+        impl().writeZpp(addr, {&_packet[6uz], count});
+#endif
+      }
+      break;
+    // Blocks have already been written while receiving
+    case Command::ZppWriteBurst: break;
+#if !ZUSI_RX_CHUNK_SIZE
+    case Command::ZppWriteCompressed:
+      if constexpr (is_enabled_command(Command::ZppWriteCompressed)) {
+        std::array<uint8_t, compression_window> block;
+        size_t const count{_packet[1uz] + 1uz};
+        if (auto const length{decompress({&_packet[6uz], count}, block)})
+          impl().writeZpp(addr, {data(block), *length});
+      }
+      break;
+#endif
+    case Command::ZppCrc32Query:
+      if constexpr (is_enabled_command(Command::ZppCrc32Query)) {
+        auto const crc{impl().crc32Zpp(data2uint32(&_packet[1uz]),
+                                       data2uint32(&_packet[5uz]))};
+        _packet.resize(5uz);
+        uint32_2data(crc, begin(_packet));
+        _packet[4uz] = impl().accumulateCrc8({cbegin(_packet), 4uz}, 0u);
+        retval = State::TransmitData;
+      }
+      break;
+    case Command::Features: {
+      auto const feature_bytes{impl().features()};
+      std::copy(cbegin(feature_bytes), cend(feature_bytes), begin(_packet));
+      _packet.resize(size(feature_bytes));
+      retval = State::TransmitData;
+      break;
+    }
+    case Command::Capabilities:
+      if constexpr (is_enabled_command(Command::Capabilities)) {
+        // Sent twice since a CRC can't survive the wired AND of several
+        // devices
+        auto const bytes{_packet[1uz]
+                           ? CapabilityBytes{}
+                           : capabilities2data(impl().capabilities())};
+        _packet.resize(2uz * size(bytes));
+        std::ranges::copy(bytes, begin(_packet));
+        std::ranges::copy(bytes, begin(_packet) + ssize(bytes));
+        retval = State::TransmitData;
+      }
+      break;
+    case Command::Exit: {
+      impl().exit(_packet[3uz]);
+      break;
+    }
+    case Command::ZppLcDcQuery:
+      if constexpr (is_enabled_command(Command::ZppLcDcQuery)) {
+        std::span<uint8_t const, 4uz> developer_code{&_packet[1uz], 4uz};
+        _packet[0uz] = impl().loadCodeValid(developer_code);
+        _packet[1uz] = impl().accumulateCrc8({cbegin(_packet), 1uz}, 0u);
+        _packet.resize(2uz);
+        retval = State::TransmitData;
+      }
+      break;
+    default: break;
+  }
+  return retval;
+}
+
+/// Reset data and state
+///
+/// \return State
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::reset() {
+  impl().spiSlave();
+#if ZUSI_RX_CHUNK_SIZE
+  if constexpr (ZUSI_RX_ZPP_WRITE)
+    if (_staged) impl().discardZpp();
+  _staged = false;
+#endif
+  _crc = 0u;
+  _ack = false;
+  _burst = false;
+  return State::ReceiveCommand;
+}
+
+/// Set cause of next transition
+///
+/// \param  cause Cause
+template<typename Impl>
+void StaticBase<Impl>::note([[maybe_unused]] Cause cause) {
+#if ZUSI_RX_EVENT_LOG_SIZE
+  _cause = cause;
+#endif
+}
+
+/// Enter error state
+///
+/// \param  cause Cause
+/// \return State::Error
+template<typename Impl>
+StaticBase<Impl>::State StaticBase<Impl>::error(Cause cause) {
+  note(cause);
+  return State::Error;
+}
+
+/// Receive bytes
+///
+/// The CRC8 gets accumulated once all bytes have been received, so that a CRC
+/// unit can take them as a single block.
+///
+/// \param  count Number of bytes to receive
+/// \retval true  Success
+/// \retval false Failure
+template<typename Impl>
+bool StaticBase<Impl>::receiveBytes(size_t count) {
+  if (size(_packet) + count > _packet.capacity()) return false;
+  auto const first{size(_packet)};
+  for (auto i{0uz}; i < count; ++i)
+    if (auto const byte{impl().receiveByte()}; !byte) return false;
+    else _packet.push_back(*byte);
+  _crc = impl().accumulateCrc8({&_packet[first], count}, _crc);
+  return true;
+}
+
+/// Receive bytes without storing them
+///
+/// Keeps the CRC8 up to date, so that the resync byte is found at the right
+/// position and a transmission error is still logged as such.
+///
+/// \param  count Number of bytes to skip
+/// \retval true  Success
+/// \retval false Failure
+template<typename Impl>
+bool StaticBase<Impl>::skipBytes(size_t count) {
+  for (auto i{0uz}; i < count; ++i)
+    if (auto const byte{impl().receiveByte()}; !byte) return false;
+    else _crc = impl().accumulateCrc8({&*byte, 1uz}, _crc);
+  return true;
+}
+
+#if ZUSI_RX_CHUNK_SIZE
+/// Receive ZPP data in chunks and stage them
+///
+/// The header stays in the buffer so that the address can still be validated
+/// before deciding whether to acknowledge or not.
+///
+/// \param  addr  Address of first data byte
+/// \param  count Number of data bytes to receive
+/// \retval true  Success
+/// \retval false Failure
+template<typename Impl>
+bool StaticBase<Impl>::receiveChunks(uint32_t addr, size_t count)
+  requires(ZUSI_RX_ZPP_WRITE)
+{
+  for (auto i{0uz}; i < count; i += ZUSI_RX_CHUNK_SIZE) {
+    auto const chunk_size{std::min<size_t>(count - i, ZUSI_RX_CHUNK_SIZE)};
+    if (!receiveBytes(chunk_size)) return false;
+    _staged = true;
+    impl().stageZpp(static_cast<uint32_t>(addr + i),
+                    {&_packet[data_pos], chunk_size});
+    _packet.resize(data_pos);
+  }
+  return receiveBytes(1uz); // CRC8
+}
+#else
+/// Receive parity of ZPP-Write-FEC and correct packet
+///
+/// The CRC8 gets recalculated after a correction. Uncorrectable packets are
+/// left as they are, so their CRC8 decides. The command byte isn't covered by
+/// the parity and the size byte has already been used to receive the packet,
+/// so errors in either can't be corrected and end up as CRC error or timeout.
+///
+/// \retval true  Success
+/// \retval false Failure
+template<typename Impl>
+bool StaticBase<Impl>::receiveParity()
+  requires(is_enabled_command(Command::ZppWriteFec))
+{
+  FecParity parity;
+  for (auto& byte : parity)
+    if (auto const retval{impl().receiveByte()}) byte = *retval;
+    else return false;
+  std::span const protected_bytes{&_packet[data_cnt_pos],
+                                  size(_packet) - data_cnt_pos};
+  if (auto const corrected{fec_decode(protected_bytes, parity)};
+      corrected && *corrected)
+    _crc = impl().accumulateCrc8({cbegin(_packet), size(_packet)}, 0u);
+  return true;
+}
+#endif
+
+/// Receive blocks of ZPP-Write-Burst
+///
+/// Every block gets checked on its own and is followed by a busy phase, during
+/// which it gets written (or committed) if its CRC8 and address are valid. A
+/// receiver only has to hold a single block and the host waits for every
+/// write to finish. Once a block is invalid the remaining ones are still
+/// received but no longer written and the burst gets not acknowledged.
+///
+/// \warning
+/// Flash gets written before the burst is acknowledged. A burst which is not
+/// acknowledged may have been written partially.
+///
+/// \retval true  Success
+/// \retval false Failure
+template<typename Impl>
+bool StaticBase<Impl>::receiveBurst()
+  requires(is_enabled_command(Command::ZppWriteBurst))
+{
+  _packet.resize(data_pos);
+  auto const addr{data2uint32(&_packet[addr_pos])};
+  size_t const count{_packet[1uz] + 1uz};
+  _burst = true;
+  for (auto i{0uz}; i < count; ++i) {
+    auto const block_addr{
+      static_cast<uint32_t>(addr + i * zpp_write_burst_block_size)};
+    _crc = 0u;
+#if ZUSI_RX_CHUNK_SIZE
+    if (!receiveChunks(block_addr, zpp_write_burst_block_size)) return false;
+#else
+    if (!receiveBytes(zpp_write_burst_block_size + 1uz)) return false;
+#endif
+    _burst = _burst && !_crc && impl().addressValid(block_addr);
+    impl().gpioOutput();
+    if (!impl().waitClock(true)) return false;
+    impl().writeData(false);
+#if ZUSI_RX_CHUNK_SIZE
+    if (_burst) impl().commitZpp();
+    else impl().discardZpp();
+    _staged = false;
+#else
+    if (_burst)
+      impl().writeZpp(block_addr,
+                      {&_packet[data_pos], zpp_write_burst_block_size});
+#endif
+    if (!impl().waitClock(false)) return false;
+    impl().writeData(true);
+    impl().spiSlave();
+    _packet.resize(data_pos);
+  }
+  return true;
+}
+
+/// Transmit bytes of response phase bit by bit
+///
+/// \param  bytes Bytes to transmit
+/// \retval true  Success
+/// \retval false Timeout occurred
+template<typename Impl>
+bool StaticBase<Impl>::transmitBytes(std::span<uint8_t const> bytes) const {
+  return std::ranges::all_of(
+    bytes, [this](uint8_t byte) { return transmitByte(byte); });
+}
+
+/// Transmit byte
+///
+/// \param  byte  Byte to send
+/// \retval true  Success
+/// \retval false Failure
+template<typename Impl>
+bool StaticBase<Impl>::transmitByte(uint8_t byte) const {
+  for (auto i{0uz}; i < CHAR_BIT; ++i) {
+    if (!impl().waitClock(true)) return false;
+    impl().writeData(byte & 1u << i);
+    if (!impl().waitClock(false)) return false;
+  }
+  return true;
+}
+
+/// Decide whether to acknowledge or not acknowledge
+///
+/// \retval true  Acknowledge
+/// \retval false Not acknowledge
+template<typename Impl>
+bool StaticBase<Impl>::ackOrNack() {
+  gsl::final_action clear_crc{[this] { _crc = 0u; }};
+  switch (static_cast<Command>(_packet[0uz])) {
+    // Requires CRC and a buffer large enough for the response
+    case Command::CvRead:
+      return !_crc && _packet[1uz] + 2uz <= _packet.capacity();
+    // Requires CRC and the whole frame in the buffer
+    case Command::CvWrite:
+      return !_crc && size(_packet) == data_pos + _packet[1uz] + 2uz;
+    // Requires only CRC
+    case Command::Features: [[fallthrough]];
+    case Command::Capabilities: [[fallthrough]];
+    case Command::ZppLcDcQuery: return !_crc ? true : false;
+    // Requires CRC and support by features
+    case Command::ZppCrc32Query:
+      return !_crc && zpp_crc32_query_supported(impl().features());
+    // Requires CRC and address validation by decryption
+#if !ZUSI_RX_CHUNK_SIZE
+    case Command::ZppWriteFec:
+      if constexpr (is_enabled_command(Command::ZppWriteFec))
+        return !_crc && impl().addressValid(data2uint32(&_packet[2uz]));
+      break;
+#endif
+    case Command::ZppWrite:
+      if constexpr (is_enabled_command(Command::ZppWrite))
+        return !_crc && impl().addressValid(data2uint32(&_packet[2uz]));
+      break;
+#if !ZUSI_RX_CHUNK_SIZE
+    // Requires CRC, address validation and well-formed compressed data
+    case Command::ZppWriteCompressed:
+      if constexpr (is_enabled_command(Command::ZppWriteCompressed)) {
+        auto const length{
+          decompressed_size({&_packet[6uz], _packet[1uz] + 1uz})};
+        return !_crc && length && *length &&
+               impl().addressValid(data2uint32(&_packet[2uz]));
+      }
+      break;
+#endif
+    // Requires CRC and address validation of every block
+    case Command::ZppWriteBurst: return !_crc && _burst;
+    // Requires CRC, safety bytes, support by features and address validation
+    case Command::ZppEraseRange:
+      if constexpr (is_enabled_command(Command::ZppEraseRange))
+        return !_crc && _packet[1uz] == 0x55u && _packet[2uz] == 0xAAu &&
+               zpp_erase_range_supported(impl().features()) &&
+               impl().addressValid(data2uint32(&_packet[3uz]));
+      break;
+    // Requires CRC, support by features and validation of both addresses
+    case Command::ZppCopy:
+      if constexpr (is_enabled_command(Command::ZppCopy))
+        return !_crc && zpp_copy_supported(impl().features()) &&
+               impl().addressValid(data2uint32(&_packet[1uz])) &&
+               impl().addressValid(data2uint32(&_packet[5uz]));
+      break;
+    // Requires CRC and safety bytes
+    case Command::ZppErase: [[fallthrough]];
+    case Command::Exit:
+      return !_crc && _packet[1uz] == 0x55u && _packet[2uz] == 0xAAu ? true
+                                                                     : false;
+    default: break;
+  }
+  return false;
+}
+
+} // namespace zusi::rx
@@ -0,0 +1,179 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Receive trace recording and replay
+///
+/// \file   zusi/rx/trace.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "../trace.hpp"
+#include "base.hpp"
+
+namespace zusi::rx {
+
+/// Records all hardware accesses of another receive base
+///
+/// The recorder has to be driven instead of the wrapped implementation. Every
+/// call gets forwarded, hardware accesses are appended to the trace as well.
+class Recorder final : public Base {
+public:
+  /// Ctor
+  ///
+  /// \param  impl  Implementation to record
+  /// \param  trace Trace to append to
+  Recorder(Base& impl, std::vector<uint8_t>& trace);
+
+private:
+#if ZUSI_RX_CV_READ
+  uint8_t readCv(uint32_t addr) const final;
+#endif
+#if ZUSI_RX_CV_WRITE
+  void writeCv(uint32_t addr, uint8_t byte) final;
+#endif
+#if ZUSI_RX_ZPP_ERASE
+  void eraseZpp() final;
+#endif
+#if ZUSI_RX_ZPP_ERASE_RANGE
+  void eraseZppRange(uint32_t addr, uint32_t size) final;
+#endif
+#if ZUSI_RX_ZPP_COPY
+  void copyZpp(uint32_t src, uint32_t dst, uint32_t size) final;
+#endif
+#if ZUSI_RX_ZPP_CRC32_QUERY
+  uint32_t crc32Zpp(uint32_t addr, uint32_t size) const final;
+#endif
+#if ZUSI_RX_ZPP_WRITE && ZUSI_RX_CHUNK_SIZE
+  void stageZpp(uint32_t addr, std::span<uint8_t const> bytes) final;
+  void commitZpp() final;
+  void discardZpp() final;
+#elif ZUSI_RX_ZPP_WRITE
+  void writeZpp(uint32_t addr, std::span<uint8_t const> bytes) final;
+#endif
+  Features features() const final;
+#if ZUSI_RX_CAPABILITIES
+  Capabilities capabilities() const final;
+#endif
+  void exit(uint8_t flags) final;
+#if ZUSI_RX_ZPP_LC_DC_QUERY
+  bool loadCodeValid(std::span<uint8_t const, 4uz> developer_code) const final;
+#endif
+#if ZUSI_RX_ZPP_ADDRESS
+  bool addressValid(uint32_t addr) const final;
+#endif
+#if ZUSI_RX_EVENT_LOG_SIZE
+  uint32_t timestamp() const final;
+#endif
+  std::optional<uint8_t> receiveByte() const final;
+  bool waitClock(bool state) const final;
+  void writeData(bool state) const final;
+  void spiSlave() const final;
+  void gpioOutput() const final;
+  bool transmitBytes(std::span<uint8_t const> bytes) const final;
+  void toggleLights() const final;
+  uint8_t accumulateCrc8(std::span<uint8_t const> bytes,
+                         uint8_t crc) const final;
+
+  /// Append event with current time
+  void record(trace::Event event) const;
+
+  Base& _impl;
+  mutable trace::Writer _writer;
+  std::chrono::steady_clock::time_point const _start;
+};
+
+/// Feeds a recorded trace into another receive base
+///
+/// Hardware accesses are answered from the trace while everything else gets
+/// forwarded to the wrapped implementation. Outputs are checked against the
+/// trace, the first divergence is available through mismatch.
+class Replayer final : public Base {
+public:
+  /// Ctor
+  ///
+  /// \param  impl  Implementation to feed
+  /// \param  trace Trace
+  Replayer(Base& impl, std::span<uint8_t const> trace);
+
+  /// Replay whole trace
+  ///
+  /// \retval size_t        Index of first event which did not match
+  /// \retval std::nullopt  Replay matched trace
+  std::optional<size_t> run();
+
+  /// Index of the first event which did not match
+  ///
+  /// \retval size_t        Index of event
+  /// \retval std::nullopt  No mismatch
+  std::optional<size_t> mismatch() const { return _mismatch; }
+
+private:
+#if ZUSI_RX_CV_READ
+  uint8_t readCv(uint32_t addr) const final;
+#endif
+#if ZUSI_RX_CV_WRITE
+  void writeCv(uint32_t addr, uint8_t byte) final;
+#endif
+#if ZUSI_RX_ZPP_ERASE
+  void eraseZpp() final;
+#endif
+#if ZUSI_RX_ZPP_ERASE_RANGE
+  void eraseZppRange(uint32_t addr, uint32_t size) final;
+#endif
+#if ZUSI_RX_ZPP_COPY
+  void copyZpp(uint32_t src, uint32_t dst, uint32_t size) final;
+#endif
+#if ZUSI_RX_ZPP_CRC32_QUERY
+  uint32_t crc32Zpp(uint32_t addr, uint32_t size) const final;
+#endif
+#if ZUSI_RX_ZPP_WRITE && ZUSI_RX_CHUNK_SIZE
+  void stageZpp(uint32_t addr, std::span<uint8_t const> bytes) final;
+  void commitZpp() final;
+  void discardZpp() final;
+#elif ZUSI_RX_ZPP_WRITE
+  void writeZpp(uint32_t addr, std::span<uint8_t const> bytes) final;
+#endif
+  Features features() const final;
+#if ZUSI_RX_CAPABILITIES
+  Capabilities capabilities() const final;
+#endif
+  void exit(uint8_t flags) final;
+#if ZUSI_RX_ZPP_LC_DC_QUERY
+  bool loadCodeValid(std::span<uint8_t const, 4uz> developer_code) const final;
+#endif
+#if ZUSI_RX_ZPP_ADDRESS
+  bool addressValid(uint32_t addr) const final;
+#endif
+#if ZUSI_RX_EVENT_LOG_SIZE
+  uint32_t timestamp() const final;
+#endif
+  std::optional<uint8_t> receiveByte() const final;
+  bool waitClock(bool state) const final;
+  void writeData(bool state) const final;
+  void spiSlave() const final;
+  void gpioOutput() const final;
+  bool transmitBytes(std::span<uint8_t const> bytes) const final;
+  void toggleLights() const final;
+  uint8_t accumulateCrc8(std::span<uint8_t const> bytes,
+                         uint8_t crc) const final;
+
+  /// Compare event with next one in trace
+  std::optional<trace::Event> expect(trace::Event const& event) const;
+
+  Base& _impl;
+  mutable trace::Reader _reader;
+  mutable size_t _index{};
+  mutable std::optional<size_t> _mismatch{};
+  mutable bool _end{};
+};
+
+} // namespace zusi::rx
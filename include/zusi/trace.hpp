@@ -0,0 +1,122 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Bus trace
+///
+/// \file   zusi/trace.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "mbps.hpp"
+
+namespace zusi::trace {
+
+/// Hardware access recorded in a trace
+enum struct Type : uint8_t {
+  TransmitBytes, ///< tx::Base::transmitBytes or rx::Base::transmitBytes
+  ReceiveByte,   ///< rx::Base::receiveByte
+  WriteClock,    ///< tx::Base::writeClock
+  WriteData,     ///< tx::Base::writeData or rx::Base::writeData
+  ReadData,      ///< tx::Base::readData, e.g. ACK bits
+  WaitClock,     ///< rx::Base::waitClock
+  DelayUs,       ///< tx::Base::delayUs
+  Busy,          ///< tx::Base::busy
+  SpiMaster,     ///< tx::Base::spiMaster
+  SpiSlave,      ///< rx::Base::spiSlave
+  GpioInput,     ///< tx::Base::gpioInput
+  GpioOutput,    ///< tx::Base::gpioOutput or rx::Base::gpioOutput
+  ReceiveBytes,  ///< tx::Base::receiveBytes
+};
+
+/// Single trace event
+struct Event {
+  Type type{};
+  bool state{};                     ///< Line state or success
+  Mbps mbps{};                      ///< Transmission speed
+  std::chrono::nanoseconds time{};  ///< Time since start of trace
+  uint32_t value{};                 ///< Delay/busy time in µs, wait result
+  std::span<uint8_t const> bytes{}; ///< Transmitted or received bytes
+
+  /// Compare everything except timing
+  ///
+  /// \param  other Other event
+  /// \retval true  Events are equivalent
+  /// \retval false Events differ
+  bool equivalent(Event const& other) const;
+};
+
+/// Magic and version at the beginning of a trace
+inline constexpr std::array<uint8_t, 4uz> magic{'Z', 'T', 'R', 1u};
+
+/// Append events to a trace
+///
+/// Each event is encoded as a tag byte holding type, state and speed, the
+/// time since the previous event as LEB128 and a type specific payload.
+class Writer {
+public:
+  /// Ctor
+  ///
+  /// \param  trace Trace to append to
+  explicit Writer(std::vector<uint8_t>& trace);
+
+  /// Append event
+  ///
+  /// \param  event Event
+  void write(Event const& event);
+
+private:
+  void leb128(uint64_t value);
+
+  std::vector<uint8_t>& _trace;
+  std::chrono::nanoseconds _time{};
+};
+
+/// Decode events from a trace without copying
+class Reader {
+public:
+  /// Ctor
+  ///
+  /// \param  trace Trace
+  explicit Reader(std::span<uint8_t const> trace);
+
+  /// Decode next event
+  ///
+  /// \retval Event         Next event
+  /// \retval std::nullopt  End of trace or malformed trace
+  std::optional<Event> next();
+
+  /// Check if trace was malformed
+  ///
+  /// \retval true  Trace malformed
+  /// \retval false Trace fine so far
+  bool error() const { return _error; }
+
+private:
+  std::optional<uint64_t> leb128();
+
+  std::span<uint8_t const> _trace;
+  size_t _pos{};
+  std::chrono::nanoseconds _time{};
+  bool _error{};
+};
+
+/// Find the first event in which two traces differ, ignoring timing
+///
+/// \param  a             Trace
+/// \param  b             Trace
+/// \retval size_t        Index of first differing event
+/// \retval std::nullopt  Traces are equivalent
+std::optional<size_t> first_mismatch(std::span<uint8_t const> a,
+                                     std::span<uint8_t const> b);
+
+} // namespace zusi::trace
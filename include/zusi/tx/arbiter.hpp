@@ -0,0 +1,286 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Bus arbiter
+///
+/// Not included by zusi.hpp since it requires threading support of the
+/// standard library (std::future, atomic wait), which bare-metal toolchains
+/// usually lack.
+///
+/// \file   zusi/tx/arbiter.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "../feedback.hpp"
+#include "base.hpp"
+
+namespace zusi::tx {
+
+/// Thread-safe bus arbiter layered on top of tx::Base
+///
+/// Any number of threads submit requests through a lock-free queue. A single
+/// consumer thread (either by calling poll or run) executes them ordered by
+/// priority, requests of equal priority stay in submission order. Adjacent
+/// CV-Reads of the same priority get merged into a single frame as long as
+/// their addresses overlap or touch, adjacent CV-Writes as long as their
+/// addresses are consecutive. The number of CVs per frame is limited by
+/// max_count, tx::Base additionally splits frames into single CVs unless all
+/// decoders confirmed more with Capabilities (see maxCvCount).
+///
+/// \warning
+/// Base must not be used directly while the arbiter is in use. Jobs get
+/// exclusive access to it on the consumer thread.
+class Arbiter {
+public:
+  enum struct Priority : uint8_t {
+    Interactive, ///< E.g. CV editor
+    Normal,      ///< Default for jobs
+    Bulk,        ///< E.g. ZPP update
+  };
+
+  /// Job with exclusive access to Base
+  using Job = std::move_only_function<void(Base&)>;
+
+  /// Ctor
+  ///
+  /// \param  base      Transmit base
+  /// \param  max_count Maximum number of CVs per frame
+  explicit Arbiter(Base& base, size_t max_count = 1uz)
+    : _base{base}, _max_count{std::clamp(max_count, 1uz, 256uz)} {}
+
+  Arbiter(Arbiter const&) = delete;
+  Arbiter& operator=(Arbiter const&) = delete;
+
+  /// Dtor
+  ///
+  /// Pending requests are dropped, their futures report broken promises.
+  ~Arbiter() {
+    for (auto req{_head.exchange(nullptr, std::memory_order_acquire)}; req;)
+      delete std::exchange(req, req->next);
+  }
+
+  /// Read CV
+  ///
+  /// \param  addr      CV address
+  /// \param  priority  Priority
+  /// \return Future of CV value or error of tx::Base::readCv
+  std::future<std::expected<uint8_t, std::errc>>
+  readCv(uint32_t addr, Priority priority = Priority::Interactive) {
+    return push<CvRead>(priority, addr);
+  }
+
+  /// Write CV
+  ///
+  /// \param  addr      CV address
+  /// \param  byte      CV value
+  /// \param  priority  Priority
+  /// \return Future of result of tx::Base::writeCv
+  std::future<std::expected<bool, std::errc>>
+  writeCv(uint32_t addr,
+          uint8_t byte,
+          Priority priority = Priority::Interactive) {
+    return push<CvWrite>(priority, addr, byte);
+  }
+
+  /// Transmit packet
+  ///
+  /// \param  bytes     Bytes containing packet (copied)
+  /// \param  priority  Priority
+  /// \return Future of result of tx::Base::transmit
+  std::future<Feedback> transmit(std::span<uint8_t const> bytes,
+                                 Priority priority = Priority::Bulk) {
+    return push<Transmit>(
+      priority, std::vector<uint8_t>{cbegin(bytes), cend(bytes)});
+  }
+
+  /// Submit job
+  ///
+  /// Completion is up to the job itself, e.g. by invoking a callback.
+  ///
+  /// \param  job       Job
+  /// \param  priority  Priority
+  void submit(Job job, Priority priority = Priority::Normal) {
+    push(std::make_unique<Request>(nullptr, priority, std::move(job)));
+  }
+
+  /// Execute all pending requests
+  ///
+  /// Must only be called from one thread at a time.
+  ///
+  /// \return Number of requests executed
+  size_t poll() {
+    std::vector<std::unique_ptr<Request>> reqs;
+    for (auto req{_head.exchange(nullptr, std::memory_order_acquire)}; req;)
+      reqs.emplace_back(std::exchange(req, req->next));
+    // Queue is LIFO
+    std::ranges::reverse(reqs);
+    std::ranges::stable_sort(reqs, {}, &Request::priority);
+    for (auto first{begin(reqs)}; first != end(reqs);)
+      first = execute(first, end(reqs));
+    return size(reqs);
+  }
+
+  /// Execute requests until stop is requested
+  ///
+  /// Blocks while the queue is empty.
+  ///
+  /// \param  stoken  Stop token
+  void run(std::stop_token stoken) {
+    std::stop_callback wake{stoken, [this] { notify(); }};
+    while (!stoken.stop_requested()) {
+      auto const pushed{_pushed.load(std::memory_order_acquire)};
+      if (!poll()) _pushed.wait(pushed, std::memory_order_acquire);
+    }
+  }
+
+private:
+  struct CvRead {
+    uint32_t addr{};
+    std::promise<std::expected<uint8_t, std::errc>> promise{};
+  };
+
+  struct CvWrite {
+    uint32_t addr{};
+    uint8_t byte{};
+    std::promise<std::expected<bool, std::errc>> promise{};
+  };
+
+  struct Transmit {
+    std::vector<uint8_t> bytes{};
+    std::promise<Feedback> promise{};
+  };
+
+  struct Request {
+    Request* next{};
+    Priority priority{};
+    std::variant<CvRead, CvWrite, Transmit, Job> op;
+  };
+
+  using Iterator = std::vector<std::unique_ptr<Request>>::iterator;
+
+  static_assert(std::atomic<Request*>::is_always_lock_free);
+
+  /// Create request and push it
+  ///
+  /// \tparam T         Operation
+  /// \tparam Ts...     Types of operation members
+  /// \param  priority  Priority
+  /// \param  args      Operation members
+  /// \return Future of operation
+  template<typename T, typename... Ts>
+  auto push(Priority priority, Ts&&... args)
+    -> decltype(std::declval<T&>().promise.get_future()) {
+    auto req{std::make_unique<Request>(
+      nullptr, priority, T{std::forward<Ts>(args)...})};
+    auto future{std::get<T>(req->op).promise.get_future()};
+    push(std::move(req));
+    return future;
+  }
+
+  /// Push request
+  ///
+  /// \param  req Request
+  void push(std::unique_ptr<Request> req) {
+    auto const ptr{req.release()};
+    ptr->next = _head.load(std::memory_order_relaxed);
+    while (!_head.compare_exchange_weak(
+      ptr->next, ptr, std::memory_order_release, std::memory_order_relaxed));
+    notify();
+  }
+
+  /// Wake consumer
+  void notify() {
+    _pushed.fetch_add(1u, std::memory_order_release);
+    _pushed.notify_one();
+  }
+
+  /// Execute request and all following ones merged into it
+  ///
+  /// \param  first Request
+  /// \param  last  End of requests
+  /// \return Iterator past executed requests
+  Iterator execute(Iterator first, Iterator last) {
+    auto& op{(*first)->op};
+    if (std::holds_alternative<CvRead>(op)) return readCvs(first, last);
+    else if (std::holds_alternative<CvWrite>(op)) return writeCvs(first, last);
+    else if (auto const packet{std::get_if<Transmit>(&op)})
+      packet->promise.set_value(
+        _base.transmit(std::span<uint8_t const>{packet->bytes}));
+    else std::get<Job>(op)(_base);
+    return ++first;
+  }
+
+  /// Read adjacent CVs with as few frames as possible
+  ///
+  /// \param  first First CV-Read request
+  /// \param  last  End of requests
+  /// \return Iterator past executed requests
+  Iterator readCvs(Iterator first, Iterator last) {
+    auto const addr{std::get<CvRead>((*first)->op).addr};
+    auto count{1uz};
+    auto it{std::next(first)};
+    for (; it != last && (*it)->priority == (*first)->priority; ++it) {
+      auto const read{std::get_if<CvRead>(&(*it)->op)};
+      if (!read || read->addr < addr || read->addr > addr + count) break;
+      auto const i{read->addr - addr + 1uz};
+      if (i > _max_count) break;
+      count = std::max(count, i);
+    }
+    std::array<uint8_t, 256uz> bytes{};
+    auto const result{_base.readCv(addr, {begin(bytes), count})};
+    for (auto req{first}; req != it; ++req) {
+      auto& read{std::get<CvRead>((*req)->op)};
+      if (result) read.promise.set_value(bytes[read.addr - addr]);
+      else read.promise.set_value(std::unexpected{result.error()});
+    }
+    return it;
+  }
+
+  /// Write consecutive CVs with as few frames as possible
+  ///
+  /// \param  first First CV-Write request
+  /// \param  last  End of requests
+  /// \return Iterator past executed requests
+  Iterator writeCvs(Iterator first, Iterator last) {
+    std::array<uint8_t, 256uz> bytes{};
+    auto const addr{std::get<CvWrite>((*first)->op).addr};
+    auto count{0uz};
+    auto it{first};
+    for (; it != last && (*it)->priority == (*first)->priority &&
+           count < _max_count;
+         ++it, ++count) {
+      auto const write{std::get_if<CvWrite>(&(*it)->op)};
+      if (!write || write->addr != addr + count) break;
+      bytes[count] = write->byte;
+    }
+    auto const result{_base.writeCv(addr, {cbegin(bytes), count})};
+    for (auto req{first}; req != it; ++req)
+      std::get<CvWrite>((*req)->op).promise.set_value(result);
+    return it;
+  }
+
+  Base& _base;
+  size_t _max_count{};
+  std::atomic<Request*> _head{};
+  std::atomic<uint32_t> _pushed{};
+};
+
+} // namespace zusi::tx
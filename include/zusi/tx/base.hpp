@@ -11,96 +11,25 @@
 #pragma once
 
 #include <cstdint>
-#include <expected>
 #include <span>
-#include <ztl/inplace_vector.hpp>
-#include "../features.hpp"
-#include "../feedback.hpp"
 #include "../mbps.hpp"
-#include "../packet.hpp"
+#include "static_base.hpp"
 
 namespace zusi::tx {
 
-class Base {
+/// Transmit base with virtual hardware access
+///
+/// Thin adapter which dispatches the hardware access of StaticBase through a
+/// vtable. This allows swapping implementations at runtime (e.g. for tracing)
+/// at the cost of an indirect call per bit.
+class Base : public StaticBase<Base> {
+  friend StaticBase<Base>;
+  friend class Recorder;
+
 public:
   /// Dtor
   virtual constexpr ~Base() = default;
 
-  /// Transmit entry sequence
-  void enter() const;
-
-  /// Transmit packet
-  ///
-  /// \param  packet    Packet
-  /// \return Feedback  Returned data (can be empty)
-  Feedback transmit(Packet const& packet);
-
-  /// Transmit bytes
-  ///
-  /// \param  bytes     Bytes containing ZUSI packet
-  /// \return Feedback  Returned data (can be empty)
-  Feedback transmit(std::span<uint8_t const> bytes);
-
-  /// Read CV
-  ///
-  /// \param  addr                        CV address
-  /// \retval uint8_t                     CV value
-  /// \retval std::errc::connection_reset No response
-  /// \retval std::errc::protocol_error   NAK
-  /// \retval std::errc::bad_message      CRC error
-  std::expected<uint8_t, std::errc> readCv(uint32_t addr) const;
-
-  /// Write CV
-  ///
-  /// \param  addr                        CV address
-  /// \param  byte                        CV value
-  /// \retval true                        Success
-  /// \retval std::errc::connection_reset No response
-  /// \retval std::errc::protocol_error   NAK
-  std::expected<bool, std::errc> writeCv(uint32_t addr, uint8_t byte) const;
-
-  /// Erase ZPP
-  ///
-  /// \retval true                        Success
-  /// \retval std::errc::connection_reset No response
-  /// \retval std::errc::protocol_error   NAK
-  std::expected<bool, std::errc> eraseZpp() const;
-
-  /// Write ZPP
-  ///
-  /// \param  addr                        Address
-  /// \param  bytes                       Bytes
-  /// \retval true                        Success
-  /// \retval std::errc::connection_reset No response
-  /// \retval std::errc::protocol_error   NAK
-  std::expected<bool, std::errc> writeZpp(uint32_t addr,
-                                          std::span<uint8_t const> bytes) const;
-
-  /// Features query
-  ///
-  /// \retval Features                    Feature bytes
-  /// \retval std::errc::connection_reset No response
-  /// \retval std::errc::protocol_error   NAK
-  std::expected<Features, std::errc> features();
-
-  /// Exit
-  ///
-  /// \param  flags                       Flags
-  /// \retval true                        Success
-  /// \retval std::errc::connection_reset No response
-  /// \retval std::errc::protocol_error   NAK
-  std::expected<bool, std::errc> exit(uint8_t flags) const;
-
-  /// LC-DC query
-  ///
-  /// \param  developer_code              Developer code
-  /// \retval bool                        Load code valid
-  /// \retval std::errc::connection_reset No response
-  /// \retval std::errc::protocol_error   NAK
-  /// \retval std::errc::bad_message      CRC error
-  std::expected<bool, std::errc>
-  lcDcQuery(std::span<uint8_t const, 4uz> developer_code) const;
-
 private:
   /// Transmit bytes
   virtual void transmitBytes(std::span<uint8_t const> bytes,
@@ -127,13 +56,11 @@ private:
   /// Delay microseconds
   virtual void delayUs(uint32_t us) const = 0;
 
-  /// Resync phase
-  void resync() const;
-
-  /// ACK phase
+  /// Receive bytes of response phase with SPI master
   ///
-  /// \return std::errc
-  std::errc ack() const;
+  /// \note
+  /// Default implementation reads every bit with the asynchronous clock
+  virtual void receiveBytes(std::span<uint8_t> bytes, Mbps mbps) const;
 
   /// Busy phase
   ///
@@ -141,18 +68,14 @@ private:
   /// Default implementation will block until done
   virtual void busy() const;
 
-  /// Receive ACK
-  ///
-  /// \return Received ACK
-  bool receiveAck() const;
-
-  /// Receive byte
+  /// Accumulate CRC8 of bytes
   ///
-  /// \return Received data
-  uint8_t receiveByte() const;
-
-  /// Transmission speed
-  Mbps _mbps{Mbps::_0_286};
+  /// \note
+  /// Default implementation calculates CRC8 in software
+  virtual uint8_t accumulateCrc8(std::span<uint8_t const> bytes,
+                                 uint8_t crc) const;
 };
 
+extern template class StaticBase<Base>;
+
 } // namespace zusi::tx
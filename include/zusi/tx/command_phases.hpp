@@ -0,0 +1,152 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Command phases
+///
+/// \file   zusi/tx/command_phases.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <utility>
+#include "../capabilities.hpp"
+#include "../command.hpp"
+#include "../crc8.hpp"
+#include "../fec.hpp"
+#include "../mbps.hpp"
+#include "../utility.hpp"
+
+namespace zusi::tx {
+
+/// Layout of a command and the phases following its command phase
+///
+/// Counted commands carry count + 1 at data_cnt_pos. Depending on the command
+/// this is the number of data bytes in the frame, the number of blocks after
+/// it or the number of bytes in the response.
+struct CommandPhases {
+  size_t size{};               ///< Frame size without data (0 if unknown)
+  size_t data_size{};          ///< Data bytes in frame per count
+  size_t block_size{};         ///< Blocks following frame (each with CRC8)
+  size_t trailer_size{};       ///< Bytes following frame (e.g. FEC parity)
+  std::optional<Mbps> mbps{};  ///< Fixed transmission speed
+  size_t response_size{};      ///< Response bytes without CRC8
+  size_t response_data_size{}; ///< Response bytes per count
+  bool response_crc{};         ///< Response ends with CRC8
+  bool bitwise{};              ///< Response always received bit by bit
+
+  /// Check if command is counted
+  ///
+  /// \retval true  Count at data_cnt_pos
+  /// \retval false No count
+  constexpr bool counted() const {
+    return data_size || block_size || response_data_size;
+  }
+};
+
+namespace detail {
+
+/// Phases of all commands indexed by command
+inline constexpr auto command_phases_table{[] {
+  std::array<CommandPhases, std::to_underlying(Command::ZppCopy) + 1uz> t{};
+  auto const at{[&](Command cmd) -> auto& {
+    return t[std::to_underlying(cmd)];
+  }};
+  at(Command::CvRead) = {
+    .size = 7uz, .response_data_size = 1uz, .response_crc = true};
+  at(Command::CvWrite) = {.size = data_pos + 1uz, .data_size = 1uz};
+  at(Command::ZppErase) = {.size = 4uz};
+  at(Command::ZppWrite) = {.size = data_pos + 1uz, .data_size = 1uz};
+  // Speed is negotiated by Features and Capabilities themselves
+  at(Command::Features) = {.size = 2uz,
+                           .mbps = Mbps::_0_286,
+                           .response_size = 4uz,
+                           .bitwise = true};
+  at(Command::Exit) = {.size = 5uz};
+  at(Command::ZppWriteBurst) = {.size = 7uz,
+                                .block_size = zpp_write_burst_block_size};
+  at(Command::ZppWriteCompressed) = {.size = data_pos + 1uz,
+                                     .data_size = 1uz};
+  at(Command::ZppCrc32Query) = {
+    .size = 10uz, .response_size = 4uz, .response_crc = true};
+  at(Command::ZppEraseRange) = {.size = 12uz};
+  // Capability bytes are sent twice instead of a CRC8
+  at(Command::Capabilities) = {
+    .size = 3uz,
+    .mbps = Mbps::_0_286,
+    .response_size = 2uz * std::tuple_size_v<CapabilityBytes>};
+  at(Command::ZppLcDcQuery) = {
+    .size = 6uz, .response_size = 1uz, .response_crc = true};
+  at(Command::ZppWriteFec) = {.size = data_pos + 1uz,
+                              .data_size = 1uz,
+                              .trailer_size = fec_parity_size};
+  at(Command::ZppCopy) = {.size = 14uz};
+  return t;
+}()};
+
+} // namespace detail
+
+/// Get phases of command
+///
+/// \param  cmd           Command
+/// \return CommandPhases Phases (size 0 if unknown)
+constexpr CommandPhases const& command_phases(Command cmd) {
+  auto const i{std::to_underlying(cmd)};
+  // Command::None doubles as unknown command
+  return detail::command_phases_table[i < size(detail::command_phases_table)
+                                        ? i
+                                        : std::to_underlying(Command::None)];
+}
+
+/// Layout of a packet
+struct PacketLayout {
+  CommandPhases phases{}; ///< Phases of command
+  size_t count{};         ///< Count + 1 (0 if not counted)
+  size_t frame_size{};    ///< Frame size including data and CRC8
+  size_t size{};          ///< Packet size including blocks and trailer
+  size_t response_size{}; ///< Response size including CRC8
+};
+
+/// Validate packet
+///
+/// Checks command, size and every CRC8 of a packet in a single pass. Bytes
+/// past the end of the packet are ignored.
+///
+/// \tparam F                           CRC8 function
+/// \param  bytes                       Bytes containing packet
+/// \param  crc                         CRC8 function
+/// \retval PacketLayout                Layout of packet
+/// \retval std::errc::invalid_argument Unknown command, too short or CRC error
+template<typename F = Crc8>
+constexpr std::expected<PacketLayout, std::errc>
+validate_packet(std::span<uint8_t const> bytes, F const& crc = {}) {
+  if (empty(bytes)) return std::unexpected{std::errc::invalid_argument};
+  PacketLayout layout{.phases = command_phases(Command{bytes[cmd_pos]})};
+  auto const& phases{layout.phases};
+  if (!phases.size || (phases.counted() && size(bytes) <= data_cnt_pos))
+    return std::unexpected{std::errc::invalid_argument};
+  if (phases.counted()) layout.count = bytes[data_cnt_pos] + 1uz;
+  layout.frame_size = phases.size + layout.count * phases.data_size;
+  auto const block_size{phases.block_size ? phases.block_size + 1uz : 0uz};
+  layout.size =
+    layout.frame_size + layout.count * block_size + phases.trailer_size;
+  layout.response_size = phases.response_size +
+                         layout.count * phases.response_data_size +
+                         phases.response_crc;
+  if (size(bytes) < layout.size || crc(bytes.first(layout.frame_size)))
+    return std::unexpected{std::errc::invalid_argument};
+  for (auto i{0uz}; i < layout.count && block_size; ++i)
+    if (crc(bytes.subspan(layout.frame_size + i * block_size, block_size)))
+      return std::unexpected{std::errc::invalid_argument};
+  return layout;
+}
+
+} // namespace zusi::tx
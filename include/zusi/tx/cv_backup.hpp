@@ -0,0 +1,89 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// CV backup and restore
+///
+/// \file   zusi/tx/cv_backup.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <vector>
+#include "base.hpp"
+
+namespace zusi::tx {
+
+/// Values of a contiguous CV range
+struct CvSnapshot {
+  uint32_t addr{};             ///< First CV address
+  std::vector<uint8_t> values; ///< CV values
+};
+
+/// Default maximum number of CVs per frame
+///
+/// As many as a frame can carry. tx::Base still sends single CVs unless all
+/// decoders confirmed several CVs per frame with Capabilities.
+inline constexpr size_t cv_backup_max_count{256uz};
+
+/// Magic and version at the beginning of a serialized snapshot
+inline constexpr std::array<uint8_t, 4uz> cv_snapshot_magic{'Z', 'C', 'V', 1u};
+
+/// Read a range of CVs
+///
+/// \param  base                        Transmit base
+/// \param  addr                        First CV address
+/// \param  count                       Number of CVs
+/// \param  max_count                   Maximum number of CVs per frame
+/// \retval CvSnapshot                  Snapshot
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Range out of CV address space
+std::expected<CvSnapshot, std::errc>
+backup_cvs(Base& base,
+           uint32_t addr,
+           size_t count,
+           size_t max_count = cv_backup_max_count);
+
+/// Write all CVs which differ from snapshot
+///
+/// \param  base                        Transmit base
+/// \param  snapshot                    Snapshot
+/// \param  max_count                   Maximum number of CVs per frame
+/// \retval size_t                      Number of CVs written
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Range out of CV address space
+std::expected<size_t, std::errc>
+restore_cvs(Base& base,
+            CvSnapshot const& snapshot,
+            size_t max_count = cv_backup_max_count);
+
+/// Serialize snapshot
+///
+/// The format consists of magic, big-endian address and count, the CV values
+/// and a big-endian CRC32 over everything before.
+///
+/// \param  snapshot  Snapshot
+/// \return Serialized snapshot
+std::vector<uint8_t> serialize_cv_snapshot(CvSnapshot const& snapshot);
+
+/// Deserialize snapshot
+///
+/// \param  bytes                       Serialized snapshot
+/// \retval CvSnapshot                  Snapshot
+/// \retval std::errc::invalid_argument Wrong magic or size
+/// \retval std::errc::bad_message      CRC error
+std::expected<CvSnapshot, std::errc>
+deserialize_cv_snapshot(std::span<uint8_t const> bytes);
+
+} // namespace zusi::tx
@@ -0,0 +1,137 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// CV cache
+///
+/// \file   zusi/tx/cv_cache.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <system_error>
+#include "base.hpp"
+
+namespace zusi::tx {
+
+/// Session-scoped CV cache layered on top of tx::Base
+///
+/// Known CV values and their dirty state are tracked for the whole CV address
+/// space. Scattered reads and writes get merged into contiguous ranges which
+/// are sent with as few frames as possible. The number of CVs per frame is
+/// limited by max_count, tx::Base additionally splits frames into single CVs
+/// unless all decoders confirmed more with Capabilities (see maxCvCount).
+class CvCache {
+public:
+  /// Size of the cached CV address space
+  static constexpr size_t cv_count{1024uz};
+
+  enum struct Policy : uint8_t {
+    WriteThrough, ///< Write CVs immediately
+    WriteBack,    ///< Defer writes until flush
+  };
+
+  /// Ctor
+  ///
+  /// \param  base      Transmit base
+  /// \param  policy    Write policy
+  /// \param  max_count Maximum number of CVs per frame
+  explicit CvCache(Base& base,
+                   Policy policy = Policy::WriteThrough,
+                   size_t max_count = 1uz);
+
+  /// Transmit entry sequence and invalidate cache
+  void enter();
+
+  /// Transmit fast entry sequence with fallback and invalidate cache
+  ///
+  /// \param  homogeneous                 All devices detect fast entry
+  /// \retval Features                    Feature bytes
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<Features, std::errc> enterFast(bool homogeneous = false);
+
+  /// Flush cache, exit and invalidate cache
+  ///
+  /// \param  flags                       Flags
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> exit(uint8_t flags);
+
+  /// Read CV
+  ///
+  /// \param  addr                        CV address
+  /// \retval uint8_t                     CV value
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  std::expected<uint8_t, std::errc> readCv(uint32_t addr);
+
+  /// Write CV
+  ///
+  /// \param  addr                        CV address
+  /// \param  byte                        CV value
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> writeCv(uint32_t addr, uint8_t byte);
+
+  /// Read all CVs not yet known
+  ///
+  /// \param  addrs                       CV addresses
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  /// \retval std::errc::invalid_argument Address out of range
+  std::expected<bool, std::errc> prefetch(std::span<uint32_t const> addrs);
+
+  /// Write all dirty CVs
+  ///
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> flush();
+
+  /// Forget all CV values, including dirty ones
+  void invalidate();
+
+  /// Get cached CV value
+  ///
+  /// \param  addr          CV address
+  /// \retval uint8_t       CV value
+  /// \retval std::nullopt  CV value unknown
+  std::optional<uint8_t> peek(uint32_t addr) const;
+
+  /// Check if CV has not yet been written
+  ///
+  /// \param  addr  CV address
+  /// \retval true  CV is dirty
+  /// \retval false CV is clean
+  bool dirty(uint32_t addr) const;
+
+private:
+  /// Read range of CVs into cache
+  std::expected<bool, std::errc> read(uint32_t addr, size_t count);
+
+  /// Write range of CVs from cache
+  std::expected<bool, std::errc> write(uint32_t addr, size_t count);
+
+  Base& _base;
+  std::array<uint8_t, cv_count> _values{};
+  std::bitset<cv_count> _valid{};
+  std::bitset<cv_count> _dirty{};
+  Policy _policy{};
+  size_t _max_count{};
+};
+
+} // namespace zusi::tx
@@ -0,0 +1,82 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Pre-framed ZPP image
+///
+/// \file   zusi/tx/framed_image.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace zusi::tx {
+
+/// ZPP image framed into packets ready to be transmitted
+///
+/// Every block of 256 bytes gets framed once as ZPP-Write packet (or as
+/// ZPP-Write-Compressed packet if that is smaller) including its CRC8. All
+/// packets are stored back to back in a single arena and located through an
+/// offset table, so the same image can be sent to any number of decoders
+/// without framing it again.
+class FramedImage {
+public:
+  /// Call function for every index in [0, count), possibly concurrently
+  using ForEach =
+    std::function<void(size_t count, std::function<void(size_t)> const&)>;
+
+  /// Ctor
+  FramedImage() = default;
+
+  /// Ctor
+  ///
+  /// Blocks are framed independently of each other, for_each may distribute
+  /// them across threads. The last block may be shorter than 256 bytes.
+  ///
+  /// \param  addr      Address of first block
+  /// \param  bytes     Image
+  /// \param  compress  Compress blocks which get smaller
+  /// \param  for_each  Function to call for every block
+  FramedImage(uint32_t addr,
+              std::span<uint8_t const> bytes,
+              bool compress = false,
+              ForEach const& for_each = {});
+
+  /// Number of packets
+  ///
+  /// \return Number of packets
+  size_t size() const { return empty(_offsets) ? 0uz : _offsets.size() - 1uz; }
+
+  /// Get packet
+  ///
+  /// \param  i Index
+  /// \return Packet including CRC8
+  std::span<uint8_t const> operator[](size_t i) const {
+    return std::span{_arena}.subspan(_offsets[i],
+                                     _offsets[i + 1uz] - _offsets[i]);
+  }
+
+  /// Check if packet is compressed
+  ///
+  /// \param  i     Index
+  /// \retval true  Packet is ZPP-Write-Compressed
+  /// \retval false Packet is ZPP-Write
+  bool compressed(size_t i) const;
+
+  /// Size of arena
+  ///
+  /// \return Size of all packets in bytes
+  size_t arenaSize() const { return _arena.size(); }
+
+private:
+  std::vector<uint8_t> _arena;
+  std::vector<uint32_t> _offsets;
+};
+
+} // namespace zusi::tx
@@ -0,0 +1,1309 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Statically dispatched transmit base
+///
+/// \file   zusi/tx/static_base.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <gsl/util>
+#include <span>
+#include <utility>
+#include "../capabilities.hpp"
+#include "../command.hpp"
+#include "../compression.hpp"
+#include "../crc32.hpp"
+#include "../crc8.hpp"
+#include "../features.hpp"
+#include "../fec.hpp"
+#include "../feedback.hpp"
+#include "../mbps.hpp"
+#include "../packet.hpp"
+#include "../utility.hpp"
+#include "command_phases.hpp"
+#include "framed_image.hpp"
+#include "timing.hpp"
+
+namespace zusi::tx {
+
+/// Transmit protocol on top of statically dispatched hardware access
+///
+/// Impl must derive from StaticBase<Impl> and provide the hardware access
+/// functions of tx::Base (transmitBytes, spiMaster, gpioInput, gpioOutput,
+/// writeClock, writeData, readData and delayUs) as well as optionally
+/// receiveBytes, busy and accumulateCrc8. The functions may be private if
+/// StaticBase<Impl> is declared friend. Since no call goes through a vtable,
+/// the per-bit loops can be inlined entirely.
+///
+/// \tparam Impl    Implementation type
+/// \tparam Default Timing profile used until changed at runtime
+template<typename Impl, Timing Default = mx644_timing>
+class StaticBase {
+public:
+  /// Transmit entry sequence
+  void enter() const;
+
+  /// Transmit fast entry sequence and fall back to entry sequence
+  ///
+  /// \param  homogeneous                 All devices detect fast entry
+  /// \retval Features                    Feature bytes
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<Features, std::errc> enterFast(bool homogeneous = false);
+
+  /// Transmit packet
+  ///
+  /// \note
+  /// Packet can't hold ZPP-Write-FEC frames, transmit those as bytes instead
+  ///
+  /// \param  packet    Packet
+  /// \return Feedback  Returned data (can be empty)
+  Feedback transmit(Packet const& packet);
+
+  /// Transmit bytes
+  ///
+  /// \param  bytes     Bytes containing ZUSI packet
+  /// \return Feedback  Returned data (can be empty)
+  Feedback transmit(std::span<uint8_t const> bytes);
+
+  /// Transmit packets back to back
+  ///
+  /// \note
+  /// Packet can't hold full ZPP-Write-FEC frames, see transmit(Packet const&)
+  ///
+  /// \param  packets       Packets
+  /// \param  feedbacks     Feedback of every packet
+  /// \param  stop_on_error Stop at first error
+  /// \return Number of packets transmitted
+  size_t transmit(std::span<Packet const> packets,
+                  std::span<Feedback> feedbacks,
+                  bool stop_on_error = true);
+
+  /// Transmit packets of framed image back to back
+  ///
+  /// \param  image         Framed image
+  /// \param  feedbacks     Feedback of every packet
+  /// \param  stop_on_error Stop at first error
+  /// \return Number of packets transmitted
+  size_t transmit(FramedImage const& image,
+                  std::span<Feedback> feedbacks,
+                  bool stop_on_error = true);
+
+  /// Read CV
+  ///
+  /// \param  addr                        CV address
+  /// \retval uint8_t                     CV value
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  std::expected<uint8_t, std::errc> readCv(uint32_t addr) const;
+
+  /// Read CVs
+  ///
+  /// \note
+  /// Sends a frame per CV unless maxCvCount allows more
+  ///
+  /// \param  addr                        First CV address
+  /// \param  bytes                       CV values
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  std::expected<bool, std::errc> readCv(uint32_t addr,
+                                        std::span<uint8_t> bytes) const;
+
+  /// Write CV
+  ///
+  /// \param  addr                        CV address
+  /// \param  byte                        CV value
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> writeCv(uint32_t addr, uint8_t byte) const;
+
+  /// Write CVs
+  ///
+  /// \note
+  /// Sends a frame per CV unless maxCvCount allows more
+  ///
+  /// \param  addr                        First CV address
+  /// \param  bytes                       CV values
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc>
+  writeCv(uint32_t addr, std::span<uint8_t const> bytes) const;
+
+  /// Erase ZPP
+  ///
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> eraseZpp() const;
+
+  /// Erase ZPP range
+  ///
+  /// \param  addr                        First address
+  /// \param  size                        Number of bytes
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> eraseZpp(uint32_t addr, uint32_t size) const;
+
+  /// Copy ZPP range
+  ///
+  /// \param  src                         First source address
+  /// \param  dst                         First destination address
+  /// \param  size                        Number of bytes
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc>
+  copyZpp(uint32_t src, uint32_t dst, uint32_t size) const;
+
+  /// Write ZPP
+  ///
+  /// \param  addr                        Address
+  /// \param  bytes                       Bytes
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> writeZpp(uint32_t addr,
+                                          std::span<uint8_t const> bytes) const;
+
+  /// Write pre-framed ZPP image
+  ///
+  /// \param  image                       Framed image
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> writeZpp(FramedImage const& image) const;
+
+  /// Write ZPP burst
+  ///
+  /// \param  addr                        Address of the first block
+  /// \param  bytes                       Consecutive blocks
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc>
+  writeZppBurst(uint32_t addr, std::span<uint8_t const> bytes) const;
+
+  /// Write ZPP compressed
+  ///
+  /// \param  addr                        Address
+  /// \param  bytes                       Bytes
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc>
+  writeZppCompressed(uint32_t addr, std::span<uint8_t const> bytes) const;
+
+  /// Write ZPP with forward error correction
+  ///
+  /// \param  addr                        Address
+  /// \param  bytes                       Bytes
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc>
+  writeZppFec(uint32_t addr, std::span<uint8_t const> bytes) const;
+
+  /// CRC32 query
+  ///
+  /// \param  addr                        First address
+  /// \param  size                        Number of bytes
+  /// \retval uint32_t                    CRC32 of range
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  std::expected<uint32_t, std::errc> crc32Query(uint32_t addr,
+                                                uint32_t size) const;
+
+  /// Verify range
+  ///
+  /// \param  addr                        First address
+  /// \param  bytes                       Expected content of range
+  /// \retval bool                        Range matches
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  std::expected<bool, std::errc>
+  verifyRange(uint32_t addr, std::span<uint8_t const> bytes) const;
+
+  /// Features query
+  ///
+  /// \retval Features                    Feature bytes
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<Features, std::errc> features();
+
+  /// Capabilities query
+  ///
+  /// \param  homogeneous                 All devices answer Capabilities
+  /// \retval Capabilities                Capabilities common to all devices
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      Copies differ
+  std::expected<Capabilities, std::errc> capabilities(bool homogeneous = false);
+
+  /// Exit
+  ///
+  /// \param  flags                       Flags
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<bool, std::errc> exit(uint8_t flags) const;
+
+  /// LC-DC query
+  ///
+  /// \param  developer_code              Developer code
+  /// \retval bool                        Load code valid
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  std::expected<bool, std::errc>
+  lcDcQuery(std::span<uint8_t const, 4uz> developer_code) const;
+
+  /// Get timing profile
+  ///
+  /// \return Timing profile
+  constexpr Timing const& timing() const { return _timing; }
+
+  /// Set timing profile
+  ///
+  /// \param  timing  Timing profile
+  constexpr void timing(Timing const& timing) { _timing = timing; }
+
+  /// Get maximum number of CVs per frame
+  ///
+  /// Legacy decoders ACK a CV-Write of several CVs but only write the first
+  /// one, and a CV-Read of 128 or 255 CVs from them can pass the CRC8 check.
+  /// Only after all devices confirmed it with Capabilities on a homogeneous
+  /// bus, CV-Read and CV-Write carry more than a single CV.
+  ///
+  /// \return Maximum number of CVs per frame
+  constexpr size_t maxCvCount() const { return _max_cv_count; }
+
+protected:
+  /// Dtor
+  constexpr ~StaticBase() {
+    static_assert(
+      requires(Impl const& impl,
+               std::span<uint8_t const> bytes,
+               std::span<uint8_t> buffer,
+               Mbps mbps,
+               uint8_t crc,
+               bool state,
+               uint32_t us) {
+        impl.transmitBytes(bytes, mbps);
+        impl.spiMaster();
+        impl.gpioInput();
+        impl.gpioOutput();
+        impl.writeClock(state);
+        impl.writeData(state);
+        { impl.readData() } -> std::convertible_to<bool>;
+        impl.delayUs(us);
+        impl.receiveBytes(buffer, mbps);
+        impl.busy();
+        { impl.accumulateCrc8(bytes, crc) } -> std::convertible_to<uint8_t>;
+      },
+      "Impl does not provide (accessible) hardware access functions");
+  }
+
+  /// Receive bytes of response phase with SPI master
+  ///
+  /// Only called if all decoders support the fast response phase. The clock
+  /// runs at mbps while the data line is read (e.g. by bidirectional SPI).
+  ///
+  /// \note
+  /// Default implementation reads every bit with the asynchronous clock
+  ///
+  /// \param  bytes Bytes to receive
+  void receiveBytes(std::span<uint8_t> bytes, Mbps) const;
+
+  /// Busy phase
+  ///
+  /// \note
+  /// Default implementation will block until done
+  void busy() const;
+
+  /// Accumulate CRC8 of bytes
+  ///
+  /// Allows a CRC unit configured for polynomial 0x31 (reflected, no final
+  /// XOR) to frame ZPP-Write, ZPP-Write-Burst and CV-Write packets and to
+  /// check responses, e.g. fed by DMA.
+  ///
+  /// \note
+  /// Default implementation calculates CRC8 in software
+  ///
+  /// \param  bytes Bytes to accumulate
+  /// \param  crc   Running CRC8 of previous bytes
+  /// \return CRC8
+  uint8_t accumulateCrc8(std::span<uint8_t const> bytes, uint8_t crc) const {
+    return crc8(bytes, crc);
+  }
+
+private:
+  /// Implementation
+  ///
+  /// \return Implementation
+  constexpr Impl const& impl() const {
+    return static_cast<Impl const&>(*this);
+  }
+
+  /// CRC8 function for packet builders
+  ///
+  /// \return CRC8 function calling Impl
+  constexpr auto crc8Fn() const {
+    return [this](std::span<uint8_t const> bytes) {
+      return impl().accumulateCrc8(bytes, 0u);
+    };
+  }
+
+  /// Execute command
+  ///
+  /// \tparam F                           Command phase
+  /// \tparam G                           Work done while decoders execute
+  /// \param  phases                      Command phases
+  /// \param  command_phase               Transmits frame at given speed
+  /// \param  response                    Response including CRC8
+  /// \param  while_busy                  Called before busy phase
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  template<std::invocable<Mbps> F, std::invocable G>
+  std::expected<bool, std::errc> execute(CommandPhases const& phases,
+                                         F&& command_phase,
+                                         std::span<uint8_t> response,
+                                         G&& while_busy) const;
+
+  /// Execute command
+  ///
+  /// \param  phases                      Command phases
+  /// \param  frame                       Frame including CRC8
+  /// \param  response                    Response including CRC8
+  /// \retval true                        Success
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      CRC error
+  std::expected<bool, std::errc>
+  execute(CommandPhases const& phases,
+          std::span<uint8_t const> frame,
+          std::span<uint8_t> response = {}) const;
+
+  /// Transmit validated packet
+  ///
+  /// \tparam G                           Work done while decoders execute
+  /// \param  packet                      Packet
+  /// \param  layout                      Layout of packet
+  /// \param  while_busy                  Called before busy phase
+  /// \return Feedback                    Returned data (can contain error)
+  template<std::invocable G>
+  Feedback transmit(std::span<uint8_t const> packet,
+                    PacketLayout const& layout,
+                    G&& while_busy);
+
+  /// Transmit packets back to back
+  ///
+  /// \tparam F             Packet at index
+  /// \param  count         Number of packets
+  /// \param  packet        Returns packet at index
+  /// \param  feedbacks     Feedback of every packet
+  /// \param  stop_on_error Stop at first error
+  /// \return Number of packets transmitted
+  template<std::invocable<size_t> F>
+  size_t transmitBatch(size_t count,
+                       F&& packet,
+                       std::span<Feedback> feedbacks,
+                       bool stop_on_error);
+
+  /// Features query
+  ///
+  /// \param  frame                       Features frame
+  /// \retval Features                    Feature bytes
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  std::expected<Features, std::errc> features(std::span<uint8_t const> frame);
+
+  /// Capabilities query
+  ///
+  /// \param  frame                       Capabilities frame
+  /// \param  homogeneous                 All devices answer Capabilities
+  /// \retval Capabilities                Capabilities common to all devices
+  /// \retval std::errc::connection_reset No response
+  /// \retval std::errc::protocol_error   NAK
+  /// \retval std::errc::bad_message      Copies differ
+  std::expected<Capabilities, std::errc>
+  capabilities(std::span<uint8_t const> frame, bool homogeneous = false);
+
+  /// Resync phase
+  void resync() const;
+
+  /// Busy phase following a block of ZPP-Write-Burst
+  void blockBusy() const;
+
+  /// ACK phase
+  ///
+  /// \return std::errc
+  std::errc ack() const;
+
+  /// Receive ACK
+  ///
+  /// \return Received ACK
+  bool receiveAck() const;
+
+  /// Receive byte
+  ///
+  /// \return Received data
+  uint8_t receiveByte() const;
+
+  /// Receive bytes of response phase
+  ///
+  /// \param  bytes Bytes to receive
+  void receiveResponse(std::span<uint8_t> bytes) const;
+
+  /// Transmission speed
+  Mbps _mbps{Mbps::_0_286};
+
+  /// Response phase at transmission speed
+  bool _fast_response{};
+
+  /// Timing profile
+  Timing _timing{Default};
+
+  /// Maximum number of CVs per frame
+  size_t _max_cv_count{1uz};
+};
+
+/// Transmit entry sequence
+template<typename Impl, Timing Default>
+void StaticBase<Impl, Default>::enter() const {
+  gsl::final_action spi_master{[this] { impl().spiMaster(); }};
+  impl().gpioOutput();
+  for (auto i{0uz}; i < entry_periods; ++i) {
+    impl().writeClock(true);
+    impl().writeData(i % 2uz);
+    impl().delayUs(_timing.entry_half_period_us);
+    impl().writeClock(false);
+    impl().delayUs(_timing.entry_half_period_us);
+  }
+  impl().delayUs(resync_timeout_us);
+}
+
+/// Transmit fast entry sequence and fall back to entry sequence
+///
+/// The fast entry sequence toggles data like the regular one, but with a 1ms
+/// clock for only 32 periods. Since ACK valid is a wired OR, a single device
+/// which detected it answers the following features query for the whole bus
+/// and legacy devices which kept running can't be noticed. Unless the caller
+/// states that all devices detect the fast entry sequence, the regular entry
+/// sequence gets transmitted right away. Otherwise it only gets transmitted
+/// if no device answers the features query.
+///
+/// \param  homogeneous                 All devices detect fast entry
+/// \retval Features                    Feature bytes
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<Features, std::errc>
+StaticBase<Impl, Default>::enterFast(bool homogeneous) {
+  if (!homogeneous) {
+    enter();
+    return features();
+  }
+  {
+    gsl::final_action spi_master{[this] { impl().spiMaster(); }};
+    impl().gpioOutput();
+    for (auto i{0uz}; i < fast_entry_periods; ++i) {
+      impl().writeClock(true);
+      impl().writeData(i % 2uz);
+      impl().delayUs(fast_entry_period_us / 2u);
+      impl().writeClock(false);
+      impl().delayUs(fast_entry_period_us / 2u);
+    }
+    impl().delayUs(resync_timeout_us);
+  }
+  if (auto const feats{features()};
+      feats || feats.error() != std::errc::connection_reset)
+    return feats;
+  enter();
+  return features();
+}
+
+/// Transmit packet
+///
+/// A full ZPP-Write-FEC frame plus its parity exceeds the capacity of Packet.
+/// Rather than failing validation depending on the block size, ZPP-Write-FEC
+/// is rejected altogether.
+///
+/// \param  packet                      Packet
+/// \return Feedback                    Returned data (can contain error)
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Unknown command or malformed packet
+/// \retval std::errc::not_supported    ZPP-Write-FEC
+/// \retval std::errc::value_too_large  Response larger than Feedback
+template<typename Impl, Timing Default>
+Feedback StaticBase<Impl, Default>::transmit(Packet const& packet) {
+  if (!empty(packet) &&
+      std::bit_cast<Command>(packet[cmd_pos]) == Command::ZppWriteFec)
+    return std::unexpected{std::errc::not_supported};
+  return transmit({cbegin(packet), size(packet)});
+}
+
+/// Transmit bytes
+///
+/// The packet is validated once and then sent as it is. Responses larger than
+/// Feedback are rejected, Capabilities only returns a single copy.
+///
+/// \param  bytes                       Bytes containing packet
+/// \return Feedback                    Returned data (can contain error)
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Unknown command or malformed packet
+/// \retval std::errc::value_too_large  Response larger than Feedback
+template<typename Impl, Timing Default>
+Feedback StaticBase<Impl, Default>::transmit(std::span<uint8_t const> bytes) {
+  auto const layout{validate_packet(bytes, crc8Fn())};
+  if (!layout) return std::unexpected{layout.error()};
+  return transmit(bytes.first(layout->size), *layout, [] {});
+}
+
+/// Transmit packets back to back
+///
+/// Every packet is validated while decoders are busy executing the previous
+/// one. Packets which fail validation are not sent and get
+/// std::errc::invalid_argument as feedback.
+///
+/// \param  packets       Packets
+/// \param  feedbacks     Feedback of every packet
+/// \param  stop_on_error Stop at first error
+/// \return Number of packets transmitted
+template<typename Impl, Timing Default>
+size_t StaticBase<Impl, Default>::transmit(std::span<Packet const> packets,
+                                           std::span<Feedback> feedbacks,
+                                           bool stop_on_error) {
+  return transmitBatch(
+    size(packets),
+    [&](size_t i) {
+      return std::span<uint8_t const>{cbegin(packets[i]), size(packets[i])};
+    },
+    feedbacks,
+    stop_on_error);
+}
+
+/// Transmit packets of framed image back to back
+///
+/// \param  image         Framed image
+/// \param  feedbacks     Feedback of every packet
+/// \param  stop_on_error Stop at first error
+/// \return Number of packets transmitted
+template<typename Impl, Timing Default>
+size_t StaticBase<Impl, Default>::transmit(FramedImage const& image,
+                                           std::span<Feedback> feedbacks,
+                                           bool stop_on_error) {
+  return transmitBatch(
+    image.size(), [&](size_t i) { return image[i]; }, feedbacks, stop_on_error);
+}
+
+/// Read CV
+///
+/// \param  addr                        CV address
+/// \retval uint8_t                     CV value
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+template<typename Impl, Timing Default>
+std::expected<uint8_t, std::errc>
+StaticBase<Impl, Default>::readCv(uint32_t addr) const {
+  uint8_t cv{};
+  if (auto const result{readCv(addr, {&cv, 1uz})}) return cv;
+  else return std::unexpected{result.error()};
+}
+
+/// Read CVs
+///
+/// The CVs get split into frames of at most maxCvCount CVs.
+///
+/// \param  addr                        First CV address
+/// \param  bytes                       CV values
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::readCv(uint32_t addr,
+                                  std::span<uint8_t> bytes) const {
+  assert(size(bytes) && size(bytes) <= 256uz);
+  std::array<uint8_t, 256uz + 1uz> response;
+  for (auto i{0uz}; i < size(bytes); i += _max_cv_count) {
+    auto const cvs{
+      bytes.subspan(i, std::min(size(bytes) - i, _max_cv_count))};
+    auto const received{std::span{response}.first(size(cvs) + 1uz)};
+    auto const result{
+      execute(command_phases(Command::CvRead),
+              make_cv_read_frame(static_cast<uint8_t>(size(cvs) - 1uz),
+                                 static_cast<uint32_t>(addr + i)),
+              received)};
+    std::ranges::copy(received.first(size(cvs)), begin(cvs));
+    if (!result) return result;
+  }
+  return true;
+}
+
+/// Write CV
+///
+/// \param  addr  CV address
+/// \param  byte  CV value
+/// \retval true  Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::writeCv(uint32_t addr, uint8_t byte) const {
+  return execute(command_phases(Command::CvWrite),
+                 make_cv_write_frame(addr, byte));
+}
+
+/// Write CVs
+///
+/// The CVs get split into frames of at most maxCvCount CVs.
+///
+/// \param  addr                        First CV address
+/// \param  bytes                       CV values
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::writeCv(uint32_t addr,
+                                   std::span<uint8_t const> bytes) const {
+  assert(size(bytes) && size(bytes) <= 256uz);
+  for (auto i{0uz}; i < size(bytes); i += _max_cv_count) {
+    auto const cvs{
+      bytes.subspan(i, std::min(size(bytes) - i, _max_cv_count))};
+    if (auto const result{execute(
+          command_phases(Command::CvWrite),
+          make_cv_write_packet(static_cast<uint8_t>(size(cvs) - 1uz),
+                               static_cast<uint32_t>(addr + i),
+                               cvs,
+                               crc8Fn()))};
+        !result)
+      return result;
+  }
+  return true;
+}
+
+/// Erase ZPP
+///
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc> StaticBase<Impl, Default>::eraseZpp() const {
+  return execute(command_phases(Command::ZppErase), zpp_erase_frame);
+}
+
+/// Erase ZPP range
+///
+/// Only decoders which advertise ZPP-Erase-Range in their features understand
+/// this command. Decoders may erase more than the range, e.g. whole sectors.
+///
+/// \param  addr                        First address
+/// \param  size                        Number of bytes
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::eraseZpp(uint32_t addr, uint32_t size) const {
+  return execute(command_phases(Command::ZppEraseRange),
+                 make_zpp_erase_range_frame(addr, size));
+}
+
+/// Copy ZPP range
+///
+/// Only decoders which advertise ZPP-Copy in their features understand this
+/// command. The source range must have been written before and must not
+/// overlap the destination range.
+///
+/// \param  src                         First source address
+/// \param  dst                         First destination address
+/// \param  size                        Number of bytes
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::copyZpp(uint32_t src,
+                                   uint32_t dst,
+                                   uint32_t size) const {
+  return execute(command_phases(Command::ZppCopy),
+                 make_zpp_copy_frame(src, dst, size));
+}
+
+/// Write ZPP
+///
+/// \param  addr                        Address
+/// \param  bytes                       Bytes
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::writeZpp(uint32_t addr,
+                                    std::span<uint8_t const> bytes) const {
+  assert(size(bytes) <= 256uz);
+  return execute(command_phases(Command::ZppWrite),
+                 make_zpp_write_packet(static_cast<uint8_t>(size(bytes) - 1uz),
+                                       addr,
+                                       bytes,
+                                       crc8Fn()));
+}
+
+/// Write pre-framed ZPP image
+///
+/// Packets are sent as they are without framing them again. Writing stops at
+/// the first packet which isn't acknowledged.
+///
+/// \param  image                       Framed image
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::writeZpp(FramedImage const& image) const {
+  for (auto i{0uz}; i < image.size(); ++i)
+    if (auto const result{execute(
+          command_phases(Command{image[i][cmd_pos]}), image[i])};
+        !result)
+      return result;
+  return true;
+}
+
+/// Write ZPP burst
+///
+/// All blocks share a single resync and ACK phase. Every block is followed by
+/// a busy phase of its own, during which decoders write it. Only decoders
+/// which advertise ZPP-Write-Burst in their features understand this command.
+/// On NAK an unknown number of blocks has already been written, the whole
+/// burst can be repeated though.
+///
+/// \param  addr                        Address of the first block
+/// \param  bytes                       Consecutive blocks
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::writeZppBurst(uint32_t addr,
+                                         std::span<uint8_t const> bytes) const {
+  auto const blocks{size(bytes) / zpp_write_burst_block_size};
+  assert(blocks && blocks <= zpp_write_burst_max_blocks &&
+         !(size(bytes) % zpp_write_burst_block_size));
+  return execute(
+    command_phases(Command::ZppWriteBurst),
+    [&](Mbps mbps) {
+      impl().transmitBytes(
+        make_zpp_write_burst_frame(static_cast<uint8_t>(blocks - 1uz), addr),
+        mbps);
+      for (auto i{0uz}; i < blocks; ++i) {
+        impl().transmitBytes(
+          make_zpp_write_burst_block(
+            bytes.subspan(i * zpp_write_burst_block_size)
+              .template first<zpp_write_burst_block_size>(),
+            crc8Fn()),
+          mbps);
+        blockBusy();
+      }
+    },
+    {},
+    [] {});
+}
+
+/// Write ZPP compressed
+///
+/// The bytes get compressed on the fly. Blocks which do not get smaller are
+/// sent as plain ZPP-Write instead. Only decoders which advertise
+/// ZPP-Write-Compressed in their features understand this command.
+///
+/// \param  addr                        Address
+/// \param  bytes                       Bytes
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::writeZppCompressed(
+  uint32_t addr, std::span<uint8_t const> bytes) const {
+  assert(size(bytes) && size(bytes) <= compression_window);
+  std::array<uint8_t, compression_window> compressed;
+  auto const count{
+    compress(bytes, std::span{compressed}.first(size(bytes) - 1uz))};
+  if (!count) return writeZpp(addr, bytes);
+  return execute(command_phases(Command::ZppWriteCompressed),
+                 make_zpp_write_compressed_packet(
+                   addr, std::span{compressed}.first(count), crc8Fn()));
+}
+
+/// Write ZPP with forward error correction
+///
+/// The packet is followed by parity bytes which let decoders correct a single
+/// bit error per bit lane instead of answering with NAK. Only decoders which
+/// advertise ZPP-Write-FEC in their features understand this command.
+///
+/// \param  addr                        Address
+/// \param  bytes                       Bytes
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::writeZppFec(uint32_t addr,
+                                       std::span<uint8_t const> bytes) const {
+  assert(size(bytes) && size(bytes) <= 256uz);
+  auto const packet{make_zpp_write_fec_packet(
+    static_cast<uint8_t>(size(bytes) - 1uz), addr, bytes, crc8Fn())};
+  auto const parity{make_zpp_write_fec_parity(packet)};
+  return execute(
+    command_phases(Command::ZppWriteFec),
+    [&](Mbps mbps) {
+      impl().transmitBytes(packet, mbps);
+      impl().transmitBytes(parity, mbps);
+    },
+    {},
+    [] {});
+}
+
+/// CRC32 query
+///
+/// Only decoders which advertise ZPP-CRC32-Query in their features understand
+/// this command. Calculating the CRC32 of large ranges happens during the busy
+/// phase and can take a while.
+///
+/// \param  addr                        First address
+/// \param  size                        Number of bytes
+/// \retval uint32_t                    CRC32 of range
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+template<typename Impl, Timing Default>
+std::expected<uint32_t, std::errc>
+StaticBase<Impl, Default>::crc32Query(uint32_t addr, uint32_t size) const {
+  std::array<uint8_t, 4uz + 1uz> bytes;
+  if (auto const result{execute(command_phases(Command::ZppCrc32Query),
+                                make_zpp_crc32_query_frame(addr, size),
+                                bytes)})
+    return data2uint32(cbegin(bytes));
+  else return std::unexpected{result.error()};
+}
+
+/// Verify range
+///
+/// Compares the CRC32 of a range in the decoder with that of bytes.
+///
+/// \param  addr                        First address
+/// \param  bytes                       Expected content of range
+/// \retval bool                        Range matches
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::verifyRange(uint32_t addr,
+                                       std::span<uint8_t const> bytes) const {
+  if (auto const crc{crc32Query(addr, static_cast<uint32_t>(size(bytes)))})
+    return *crc == crc32(bytes);
+  else return std::unexpected{crc.error()};
+}
+
+/// Features query
+///
+/// \retval Features                    Feature bytes
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<Features, std::errc> StaticBase<Impl, Default>::features() {
+  return features(features_frame);
+}
+
+/// Capabilities query
+///
+/// Devices send their capability bytes twice, the copies have to match. The
+/// fastest transmission speed all devices have in common gets enabled. The
+/// fast response phase and timing only get enabled if the caller states that
+/// all devices answer Capabilities.
+///
+/// \param  homogeneous                 All devices answer Capabilities
+/// \retval Capabilities                Capabilities common to all devices
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      Copies differ
+template<typename Impl, Timing Default>
+std::expected<Capabilities, std::errc>
+StaticBase<Impl, Default>::capabilities(bool homogeneous) {
+  return capabilities(make_capabilities_frame(), homogeneous);
+}
+
+/// Exit
+///
+/// \param  flags                       Flags
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::exit(uint8_t flags) const {
+  return execute(command_phases(Command::Exit), make_exit_frame(flags));
+}
+
+/// LC-DC query
+///
+/// \param  developer_code              Developer code
+/// \retval bool                        Load code valid
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc> StaticBase<Impl, Default>::lcDcQuery(
+  std::span<uint8_t const, 4uz> developer_code) const {
+  std::array<uint8_t, 1uz + 1uz> bytes;
+  if (auto const result{execute(command_phases(Command::ZppLcDcQuery),
+                                make_zpp_lc_dc_query_frame(developer_code),
+                                bytes)})
+    return static_cast<bool>(bytes[0uz]);
+  else return std::unexpected{result.error()};
+}
+
+/// Transmit validated packet
+///
+/// \tparam G                           Work done while decoders execute
+/// \param  packet                      Packet
+/// \param  layout                      Layout of packet
+/// \param  while_busy                  Called before busy phase
+/// \return Feedback                    Returned data (can contain error)
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::value_too_large  Response larger than Feedback
+template<typename Impl, Timing Default>
+template<std::invocable G>
+Feedback StaticBase<Impl, Default>::transmit(std::span<uint8_t const> packet,
+                                             PacketLayout const& layout,
+                                             G&& while_busy) {
+  switch (std::bit_cast<Command>(packet.front())) {
+    case Command::Features:
+      // Speed changes, next packet can't be prepared in advance
+      std::invoke(std::forward<G>(while_busy));
+      if (auto const feats{features(packet)})
+        return Feedback::value_type{cbegin(*feats), cend(*feats)};
+      else return std::unexpected{feats.error()};
+    case Command::Capabilities:
+      std::invoke(std::forward<G>(while_busy));
+      if (auto const caps{capabilities(packet)}) {
+        auto const data{capabilities2data(*caps)};
+        return Feedback::value_type{cbegin(data), cend(data)};
+      } else return std::unexpected{caps.error()};
+    default: break;
+  }
+
+  std::array<uint8_t, ZUSI_MAX_FEEDBACK_SIZE + 1uz> buffer;
+  if (layout.response_size > size(buffer)) {
+    std::invoke(std::forward<G>(while_busy));
+    return std::unexpected{std::errc::value_too_large};
+  }
+  auto const response{std::span{buffer}.first(layout.response_size)};
+  auto const& phases{layout.phases};
+  if (auto const result{execute(
+        phases,
+        [&](Mbps mbps) {
+          // Frame, blocks and trailer are sent like the methods send them
+          impl().transmitBytes(packet.first(layout.frame_size), mbps);
+          auto const block_size{phases.block_size + 1uz};
+          for (auto i{0uz}; i < layout.count && phases.block_size; ++i) {
+            impl().transmitBytes(
+              packet.subspan(layout.frame_size + i * block_size, block_size),
+              mbps);
+            blockBusy();
+          }
+          if (phases.trailer_size)
+            impl().transmitBytes(packet.last(phases.trailer_size), mbps);
+        },
+        response,
+        std::forward<G>(while_busy))};
+      !result)
+    return std::unexpected{result.error()};
+  return Feedback::value_type{
+    cbegin(response), cend(response) - phases.response_crc};
+}
+
+/// Transmit packets back to back
+///
+/// \tparam F             Packet at index
+/// \param  count         Number of packets
+/// \param  packet        Returns packet at index
+/// \param  feedbacks     Feedback of every packet
+/// \param  stop_on_error Stop at first error
+/// \return Number of packets transmitted
+template<typename Impl, Timing Default>
+template<std::invocable<size_t> F>
+size_t StaticBase<Impl, Default>::transmitBatch(size_t count,
+                                                F&& packet,
+                                                std::span<Feedback> feedbacks,
+                                                bool stop_on_error) {
+  assert(size(feedbacks) >= count);
+  auto const validate{[&](size_t i) {
+    return i < count ? validate_packet(packet(i), crc8Fn())
+                     : std::unexpected{std::errc::invalid_argument};
+  }};
+  auto layout{validate(0uz)};
+  for (auto i{0uz}; i < count; ++i) {
+    std::expected<PacketLayout, std::errc> next{};
+    auto prepared{false};
+    feedbacks[i] = layout ? transmit(packet(i).first(layout->size),
+                                     *layout,
+                                     [&] {
+                                       next = validate(i + 1uz);
+                                       prepared = true;
+                                     })
+                          : std::unexpected{layout.error()};
+    if (!feedbacks[i] && stop_on_error) return i + 1uz;
+    layout = prepared ? next : validate(i + 1uz);
+  }
+  return count;
+}
+
+/// Execute command
+///
+/// Runs all phases of a command, only the command phase differs between
+/// commands.
+///
+/// \tparam F                           Command phase
+/// \tparam G                           Work done while decoders execute
+/// \param  phases                      Command phases
+/// \param  command_phase               Transmits frame at given speed
+/// \param  response                    Response including CRC8
+/// \param  while_busy                  Called before busy phase
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+template<typename Impl, Timing Default>
+template<std::invocable<Mbps> F, std::invocable G>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::execute(CommandPhases const& phases,
+                                   F&& command_phase,
+                                   std::span<uint8_t> response,
+                                   G&& while_busy) const {
+  gsl::final_action spi_master{[this] { impl().spiMaster(); }};
+  std::invoke(std::forward<F>(command_phase), phases.mbps.value_or(_mbps));
+  resync();
+  impl().gpioInput();
+  auto const err{ack()};
+  // Decoders execute the command right after ACK
+  std::invoke(std::forward<G>(while_busy));
+  if (err != std::errc{}) return std::unexpected{err};
+  impl().busy();
+  if (empty(response)) return true;
+  if (phases.bitwise)
+    std::ranges::generate(response, [this] { return receiveByte(); });
+  else receiveResponse(response);
+  if (phases.response_crc && impl().accumulateCrc8(response, 0u))
+    return std::unexpected{std::errc::bad_message};
+  return true;
+}
+
+/// Execute command
+///
+/// \param  phases                      Command phases
+/// \param  frame                       Frame including CRC8
+/// \param  response                    Response including CRC8
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+template<typename Impl, Timing Default>
+std::expected<bool, std::errc>
+StaticBase<Impl, Default>::execute(CommandPhases const& phases,
+                                   std::span<uint8_t const> frame,
+                                   std::span<uint8_t> response) const {
+  return execute(
+    phases,
+    [&](Mbps mbps) { impl().transmitBytes(frame, mbps); },
+    response,
+    [] {});
+}
+
+/// Features query
+///
+/// \param  frame                       Features frame
+/// \retval Features                    Feature bytes
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+template<typename Impl, Timing Default>
+std::expected<Features, std::errc>
+StaticBase<Impl, Default>::features(std::span<uint8_t const> frame) {
+  Features features;
+  if (auto const result{
+        execute(command_phases(Command::Features), frame, features)};
+      !result)
+    return std::unexpected{result.error()};
+  if (!(features[0uz] & 0b100u)) _mbps = Mbps::_1_807;
+  else if (!(features[0uz] & 0b010u)) _mbps = Mbps::_1_364;
+  else if (!(features[0uz] & 0b001u)) _mbps = Mbps::_0_286;
+  return features;
+}
+
+/// Capabilities query
+///
+/// Legacy decoders don't answer Capabilities and therefore can't veto it, the
+/// pulled up data line reads as if they supported everything. The transmission
+/// speed gets limited to the one common to all devices, but never raised above
+/// the one negotiated by Features. The fast response phase, timing profile
+/// and maximum number of CVs per frame are left untouched unless the caller
+/// states that all devices answer. In that case a fast timing profile which
+/// isn't confirmed anymore gets dropped again.
+///
+/// \param  frame                       Capabilities frame
+/// \param  homogeneous                 All devices answer Capabilities
+/// \retval Capabilities                Capabilities common to all devices
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      Copies differ
+template<typename Impl, Timing Default>
+std::expected<Capabilities, std::errc>
+StaticBase<Impl, Default>::capabilities(std::span<uint8_t const> frame,
+                                        bool homogeneous) {
+  std::array<uint8_t, 2uz * std::tuple_size_v<CapabilityBytes>> bytes;
+  if (auto const result{
+        execute(command_phases(Command::Capabilities), frame, bytes)};
+      !result)
+    return std::unexpected{result.error()};
+  CapabilityBytes copy;
+  std::copy_n(cbegin(bytes), size(copy), begin(copy));
+  if (!std::equal(cbegin(copy), cend(copy), cbegin(bytes) + ssize(copy)))
+    return std::unexpected{std::errc::bad_message};
+  auto const caps{data2capabilities(copy)};
+  _mbps = std::min(_mbps, std::max(caps.mbps, Mbps::_0_286));
+  if (!homogeneous) return caps;
+  _fast_response = caps.fast_response;
+  _max_cv_count = caps.cv_multiple ? 256uz : 1uz;
+  if (caps.fast_timing) _timing = fast_timing;
+  else if (_timing == fast_timing) _timing = Default;
+  return caps;
+}
+
+/// Receive bytes of response phase bit by bit
+///
+/// \param  bytes Bytes to receive
+template<typename Impl, Timing Default>
+void StaticBase<Impl, Default>::receiveBytes(std::span<uint8_t> bytes,
+                                             Mbps) const {
+  std::ranges::generate(bytes, [this] { return receiveByte(); });
+}
+
+/// Busy phase sequence
+template<typename Impl, Timing Default>
+void StaticBase<Impl, Default>::busy() const {
+  impl().writeClock(true);
+  impl().delayUs(_timing.clock_high_us);
+  impl().writeClock(false);
+  impl().delayUs(_timing.clock_low_us);
+  while (!impl().readData()); /// \todo timeout?
+}
+
+/// Transmit resync byte
+template<typename Impl, Timing Default>
+void StaticBase<Impl, Default>::resync() const {
+  impl().delayUs(_timing.resync_pause_us);
+  impl().transmitBytes({&resync_byte, 1uz}, Mbps::_0_1);
+  impl().delayUs(_timing.resync_pause_us);
+}
+
+/// Busy phase following a block of ZPP-Write-Burst
+///
+/// Like the resync byte, the pause gives decoders time to switch from SPI to
+/// GPIO.
+template<typename Impl, Timing Default>
+void StaticBase<Impl, Default>::blockBusy() const {
+  impl().delayUs(_timing.resync_pause_us);
+  impl().gpioInput();
+  impl().busy();
+  impl().spiMaster();
+}
+
+/// ACK phase
+///
+/// \return std::errc
+template<typename Impl, Timing Default>
+std::errc StaticBase<Impl, Default>::ack() const {
+  // ACK valid
+  if (auto const ack_valid{receiveAck()}, ack{receiveAck()}; ack_valid)
+    return std::errc::connection_reset;
+  // ACK
+  else if (!ack) return std::errc::protocol_error;
+  // Success
+  else return {};
+}
+
+/// Receive ACK
+///
+/// \return Received ACK
+template<typename Impl, Timing Default>
+bool StaticBase<Impl, Default>::receiveAck() const {
+  impl().writeClock(true);
+  impl().delayUs(_timing.clock_high_us);
+  auto const retval{impl().readData()};
+  impl().writeClock(false);
+  impl().delayUs(_timing.clock_low_us);
+  return retval;
+}
+
+/// Receive byte
+///
+/// \return Received byte
+template<typename Impl, Timing Default>
+uint8_t StaticBase<Impl, Default>::receiveByte() const {
+  uint8_t byte{};
+  for (auto i{0uz}; i < CHAR_BIT; ++i) {
+    impl().writeClock(true);
+    impl().delayUs(_timing.clock_high_us);
+    byte = static_cast<uint8_t>(byte | impl().readData() << i);
+    impl().writeClock(false);
+    impl().delayUs(_timing.clock_low_us);
+  }
+  return byte;
+}
+
+/// Receive bytes of response phase
+///
+/// Legacy decoders can only follow the asynchronous clock, the faster path
+/// is taken once all decoders confirmed support for it with Capabilities.
+///
+/// \param  bytes Bytes to receive
+template<typename Impl, Timing Default>
+void StaticBase<Impl, Default>::receiveResponse(
+  std::span<uint8_t> bytes) const {
+  if (_fast_response) impl().receiveBytes(bytes, _mbps);
+  else std::ranges::generate(bytes, [this] { return receiveByte(); });
+}
+
+} // namespace zusi::tx
@@ -0,0 +1,48 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Transmit timing profiles
+///
+/// \file   zusi/tx/timing.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <cstdint>
+
+namespace zusi::tx {
+
+/// Delays used by the host around the asynchronous parts of a transmission
+struct Timing {
+  uint32_t entry_half_period_us{}; ///< Clock half-period of entry sequence
+  uint32_t resync_pause_us{};      ///< Pause before and after resync byte
+  uint32_t clock_high_us{};        ///< Clock high during ACK, busy and data
+  uint32_t clock_low_us{};         ///< Clock low during ACK, busy and data
+
+  constexpr bool operator==(Timing const&) const = default;
+};
+
+/// Conservative timing every MX644 compatible decoder can follow
+inline constexpr Timing mx644_timing{.entry_half_period_us = 5000u,
+                                     .resync_pause_us = 10u,
+                                     .clock_high_us = 10u,
+                                     .clock_low_us = 20u};
+
+/// Timing measured on ULF
+inline constexpr Timing ulf_timing{.entry_half_period_us = 5000u,
+                                   .resync_pause_us = 15u,
+                                   .clock_high_us = 10u,
+                                   .clock_low_us = 20u};
+
+/// Fast timing for buses without legacy decoders
+///
+/// Decoders have to be able to follow 5µs clock phases with waitClock. The
+/// entry sequence stays unchanged since decoders detect it in a slow loop.
+inline constexpr Timing fast_timing{.entry_half_period_us = 5000u,
+                                    .resync_pause_us = 5u,
+                                    .clock_high_us = 5u,
+                                    .clock_low_us = 5u};
+
+} // namespace zusi::tx
@@ -0,0 +1,102 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Transmit trace recording and replay
+///
+/// \file   zusi/tx/trace.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "../trace.hpp"
+#include "base.hpp"
+
+namespace zusi::tx {
+
+/// Records all hardware accesses of another transmit base
+///
+/// Commands must be issued on the recorder, it forwards every hardware access
+/// to the wrapped implementation and appends it to the trace.
+class Recorder final : public Base {
+public:
+  /// Ctor
+  ///
+  /// \param  impl  Implementation to record
+  /// \param  trace Trace to append to
+  Recorder(Base& impl, std::vector<uint8_t>& trace);
+
+private:
+  void transmitBytes(std::span<uint8_t const> bytes, Mbps mbps) const final;
+  void spiMaster() const final;
+  void gpioInput() const final;
+  void gpioOutput() const final;
+  void writeClock(bool state) const final;
+  void writeData(bool state) const final;
+  bool readData() const final;
+  void delayUs(uint32_t us) const final;
+  void receiveBytes(std::span<uint8_t> bytes, Mbps mbps) const final;
+  void busy() const final;
+  uint8_t accumulateCrc8(std::span<uint8_t const> bytes,
+                         uint8_t crc) const final;
+
+  /// Append event with current time
+  void record(trace::Event event) const;
+
+  Base& _impl;
+  mutable trace::Writer _writer;
+  std::chrono::steady_clock::time_point const _start;
+};
+
+/// Answers hardware accesses from a recorded trace
+///
+/// Running the same commands which have been recorded replays the decoder
+/// responses without any hardware. Every output gets checked against the
+/// trace, the first divergence is available through mismatch.
+class Replayer final : public Base {
+public:
+  /// Ctor
+  ///
+  /// \param  trace Trace
+  explicit Replayer(std::span<uint8_t const> trace);
+
+  /// Index of the first event which did not match
+  ///
+  /// \retval size_t        Index of event
+  /// \retval std::nullopt  No mismatch
+  std::optional<size_t> mismatch() const { return _mismatch; }
+
+  /// Check if all events have been replayed
+  ///
+  /// \retval true  All events replayed
+  /// \retval false Events left
+  bool done() const;
+
+private:
+  void transmitBytes(std::span<uint8_t const> bytes, Mbps mbps) const final;
+  void spiMaster() const final;
+  void gpioInput() const final;
+  void gpioOutput() const final;
+  void writeClock(bool state) const final;
+  void writeData(bool state) const final;
+  bool readData() const final;
+  void delayUs(uint32_t us) const final;
+  void receiveBytes(std::span<uint8_t> bytes, Mbps mbps) const final;
+  void busy() const final;
+
+  /// Compare event with next one in trace
+  std::optional<trace::Event> expect(trace::Event const& event) const;
+
+  mutable trace::Reader _reader;
+  mutable size_t _index{};
+  mutable std::optional<size_t> _mismatch{};
+};
+
+} // namespace zusi::tx
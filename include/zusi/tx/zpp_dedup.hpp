@@ -0,0 +1,45 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// ZPP deduplication
+///
+/// \file   zusi/tx/zpp_dedup.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace zusi::tx {
+
+/// Range to copy with ZPP-Copy
+struct ZppCopy {
+  uint32_t src{}; ///< First source address
+  uint32_t dst{}; ///< First destination address
+  size_t size{};  ///< Number of bytes
+
+  constexpr bool operator==(ZppCopy const&) const = default;
+};
+
+/// Find blocks which repeat earlier content
+///
+/// Every whole block gets hashed by its CRC32 and compared against all earlier
+/// blocks with the same hash. A block which equals an earlier one becomes a
+/// copy of the first occurrence, consecutive copies of consecutive sources
+/// are merged. Sources are first occurrences which get written themselves, so
+/// a copy can be issued once all blocks before its destination are written.
+///
+/// \param  addr                  First address
+/// \param  bytes                 Image
+/// \param  block_size            Size of a block
+/// \return std::vector<ZppCopy>  Copies sorted by destination
+std::vector<ZppCopy> find_duplicate_blocks(uint32_t addr,
+                                           std::span<uint8_t const> bytes,
+                                           size_t block_size = 256uz);
+
+} // namespace zusi::tx
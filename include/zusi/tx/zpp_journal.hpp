@@ -0,0 +1,91 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Resumable ZPP update journal
+///
+/// \file   zusi/tx/zpp_journal.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <span>
+#include <system_error>
+#include "../features.hpp"
+
+namespace zusi::tx {
+
+/// Everything an interrupted update has to match to be resumed
+struct ZppSession {
+  uint32_t image_crc{};                       ///< CRC32 of image
+  uint32_t image_size{};                      ///< Size of image
+  Features features{};                        ///< Feature bytes
+  std::array<uint8_t, 4uz> developer_code{};  ///< Developer code of LC-DC
+  bool load_code_valid{};                     ///< Result of LC-DC query
+
+  constexpr bool operator==(ZppSession const&) const = default;
+};
+
+/// Magic and version at the beginning of a journal
+inline constexpr std::array<uint8_t, 4uz> zpp_journal_magic{'Z', 'P', 'J', 1u};
+
+/// Appends progress of a ZPP update to a journal
+///
+/// The journal consists of a header describing the session followed by a
+/// record per acknowledged write. Every record is protected by its own CRC8,
+/// so a write torn by power loss only costs the last record. The journal
+/// should be started once ZPP-Erase has been acknowledged.
+class ZppJournal {
+public:
+  /// Append bytes to persistent storage (e.g. a file opened for appending)
+  using Append = std::function<void(std::span<uint8_t const>)>;
+
+  /// Ctor
+  ///
+  /// \param  append  Append function
+  /// \param  session Session
+  ZppJournal(Append append, ZppSession const& session);
+
+  /// Record that all data up to addr has been acknowledged
+  ///
+  /// \param  addr  Address past the last acknowledged byte
+  void acknowledged(uint32_t addr) const;
+
+private:
+  Append _append;
+};
+
+/// Content of a journal
+struct ZppJournalState {
+  ZppSession session{};                 ///< Session
+  std::optional<uint32_t> acknowledged; ///< Acknowledged up to address
+};
+
+/// Parse journal
+///
+/// Records after the first torn or corrupt one are ignored.
+///
+/// \param  bytes                       Journal
+/// \retval ZppJournalState             Journal content
+/// \retval std::errc::invalid_argument Wrong magic or size
+/// \retval std::errc::bad_message      Header CRC error
+std::expected<ZppJournalState, std::errc>
+parse_zpp_journal(std::span<uint8_t const> bytes);
+
+/// Get address to resume an update at
+///
+/// \param  state         Journal content
+/// \param  session       Current session
+/// \retval uint32_t      Address to continue writing at without erasing
+/// \retval std::nullopt  Session differs, update has to start over
+std::optional<uint32_t> resume_address(ZppJournalState const& state,
+                                       ZppSession const& session);
+
+} // namespace zusi::tx
@@ -0,0 +1,50 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// ZPP verification
+///
+/// \file   zusi/tx/zpp_verify.hpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <vector>
+#include "base.hpp"
+
+namespace zusi::tx {
+
+/// Contiguous ZPP address range
+struct ZppRange {
+  uint32_t addr{}; ///< First address
+  size_t size{};   ///< Number of bytes
+
+  constexpr bool operator==(ZppRange const&) const = default;
+};
+
+/// Find ranges whose content differs from bytes
+///
+/// Ranges with a mismatching CRC32 get bisected until they are no larger than
+/// min_size. Adjacent bad ranges are merged.
+///
+/// \param  base                        Transmit base
+/// \param  addr                        First address
+/// \param  bytes                       Expected content
+/// \param  min_size                    Smallest range to bisect into
+/// \retval std::vector<ZppRange>       Bad ranges (empty if all match)
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+std::expected<std::vector<ZppRange>, std::errc>
+find_bad_ranges(Base& base,
+                uint32_t addr,
+                std::span<uint8_t const> bytes,
+                size_t min_size = 256uz);
+
+} // namespace zusi::tx
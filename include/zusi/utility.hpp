@@ -11,12 +11,17 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <iterator>
+#include <span>
 #include <utility>
 #include "command.hpp"
+#include "crc32.hpp"
 #include "crc8.hpp"
+#include "fec.hpp"
 #include "packet.hpp"
 
 namespace zusi {
@@ -29,6 +34,12 @@ inline constexpr size_t data_pos{6uz};
 inline constexpr size_t sec_bytes_pos{1uz};
 inline constexpr size_t exit_flags_pos{3uz};
 
+/// Size of a block of ZPP-Write-Burst
+inline constexpr size_t zpp_write_burst_block_size{256uz};
+
+/// Maximum number of blocks of ZPP-Write-Burst
+inline constexpr size_t zpp_write_burst_max_blocks{256uz};
+
 /// Resync byte
 inline constexpr uint8_t resync_byte{0x80u};
 
@@ -38,6 +49,18 @@ inline constexpr auto resync_timeout_ms{10u};
 /// Resync timeout in us
 inline constexpr auto resync_timeout_us{resync_timeout_ms * 1000u};
 
+/// Clock period of entry sequence in us
+inline constexpr auto entry_period_us{10'000u};
+
+/// Number of clock periods of entry sequence
+inline constexpr auto entry_periods{100uz};
+
+/// Clock period of fast entry sequence in us
+inline constexpr auto fast_entry_period_us{1000u};
+
+/// Number of clock periods of fast entry sequence
+inline constexpr auto fast_entry_periods{32uz};
+
 /// Check if byte is entry byte
 ///
 /// \param  byte  Byte to check
@@ -55,7 +78,7 @@ constexpr bool is_entry_byte(uint8_t byte) {
 constexpr bool is_valid_command(uint8_t cmd) {
   return cmd == std::clamp(cmd,
                            std::to_underlying(Command::CvRead),
-                           std::to_underlying(Command::ZppLcDcQuery));
+                           std::to_underlying(Command::ZppCopy));
 }
 
 /// Data to uint32_t
@@ -85,32 +108,263 @@ inline constexpr auto uint32_2data(uint32_t word, OutputIt out) {
   return out;
 }
 
-/// Make CV-Read packet
+/// Make CV-Read frame
 ///
 /// \param  count    CV count - 1
 /// \param  address  First CV address
+/// \return Frame
+constexpr Frame<7uz> make_cv_read_frame(uint8_t count, uint32_t address) {
+  Frame<7uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::CvRead);    // Command
+  *it++ = count;                                  // Count
+  it = uint32_2data(address, it);                 // Address
+  *it = crc8({cbegin(frame), size(frame) - 1uz}); // CRC8
+  return frame;
+}
+
+/// Make CV-Write frame
+///
+/// \tparam N        CV count
+/// \param  address  First CV address
+/// \param  values   CV values
+/// \return Frame
+template<size_t N>
+requires(N > 0uz && N <= 256uz)
+constexpr Frame<6uz + N + 1uz>
+make_cv_write_frame(uint32_t address, std::span<uint8_t const, N> values) {
+  Frame<6uz + N + 1uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::CvWrite);   // Command
+  *it++ = static_cast<uint8_t>(N - 1uz);          // Count
+  it = uint32_2data(address, it);                 // Address
+  it = std::ranges::copy(values, it).out;         // Values
+  *it = crc8({cbegin(frame), size(frame) - 1uz}); // CRC8
+  return frame;
+}
+
+/// Make CV-Write frame for a single CV
+///
+/// \param  address  CV address
+/// \param  value    CV value
+/// \return Frame
+constexpr Frame<8uz> make_cv_write_frame(uint32_t address, uint8_t value) {
+  return make_cv_write_frame(address,
+                             std::span<uint8_t const, 1uz>{&value, 1uz});
+}
+
+/// Make ZPP-Erase frame
+///
+/// \return Frame
+constexpr Frame<4uz> make_zpp_erase_frame() {
+  Frame<4uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::ZppErase);  // Command
+  *it++ = 0x55u;                                  // Security byte
+  *it++ = 0xAAu;                                  // Security byte
+  *it = crc8({cbegin(frame), size(frame) - 1uz}); // CRC8
+  return frame;
+}
+
+/// Make ZPP-Erase-Range frame
+///
+/// \param  address  First address
+/// \param  length   Number of bytes
+/// \return Frame
+constexpr Frame<12uz> make_zpp_erase_range_frame(uint32_t address,
+                                                uint32_t length) {
+  Frame<12uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::ZppEraseRange); // Command
+  *it++ = 0x55u;                                      // Security byte
+  *it++ = 0xAAu;                                      // Security byte
+  it = uint32_2data(address, it);                     // Address
+  it = uint32_2data(length, it);                      // Length
+  *it = crc8({cbegin(frame), size(frame) - 1uz});     // CRC8
+  return frame;
+}
+
+/// Make ZPP-Copy frame
+///
+/// \param  src     First source address
+/// \param  dst     First destination address
+/// \param  length  Number of bytes
+/// \return Frame
+constexpr Frame<14uz>
+make_zpp_copy_frame(uint32_t src, uint32_t dst, uint32_t length) {
+  Frame<14uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::ZppCopy);   // Command
+  it = uint32_2data(src, it);                     // Source address
+  it = uint32_2data(dst, it);                     // Destination address
+  it = uint32_2data(length, it);                  // Length
+  *it = crc8({cbegin(frame), size(frame) - 1uz}); // CRC8
+  return frame;
+}
+
+/// Make ZPP-Write frame
+///
+/// \tparam N        Chunk size
+/// \param  address  Chunk address
+/// \param  bytes    Chunk
+/// \return Frame
+template<size_t N>
+requires(N > 0uz && N <= 256uz)
+constexpr Frame<6uz + N + 1uz>
+make_zpp_write_frame(uint32_t address, std::span<uint8_t const, N> bytes) {
+  Frame<6uz + N + 1uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::ZppWrite);  // Command
+  *it++ = static_cast<uint8_t>(N - 1uz);          // Size
+  it = uint32_2data(address, it);                 // Address
+  it = std::ranges::copy(bytes, it).out;          // Flash data
+  *it = crc8({cbegin(frame), size(frame) - 1uz}); // CRC8
+  return frame;
+}
+
+/// Make ZPP-Write-Burst header frame
+///
+/// \param  count    Block count - 1
+/// \param  address  Address of the first block
+/// \return Frame
+constexpr Frame<7uz> make_zpp_write_burst_frame(uint8_t count,
+                                               uint32_t address) {
+  Frame<7uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::ZppWriteBurst); // Command
+  *it++ = count;                                      // Count
+  it = uint32_2data(address, it);                     // Address
+  *it = crc8({cbegin(frame), size(frame) - 1uz});     // CRC8
+  return frame;
+}
+
+/// Make ZPP-Write-Burst block frame
+///
+/// \tparam F      CRC8 function
+/// \param  bytes  Block
+/// \param  crc    CRC8 function
+/// \return Frame
+template<typename F = Crc8>
+constexpr Frame<zpp_write_burst_block_size + 1uz> make_zpp_write_burst_block(
+  std::span<uint8_t const, zpp_write_burst_block_size> bytes,
+  F const& crc = {}) {
+  Frame<zpp_write_burst_block_size + 1uz> frame{};
+  auto it{std::ranges::copy(bytes, begin(frame)).out}; // Flash data
+  *it = crc(bytes);                                    // CRC8
+  return frame;
+}
+
+/// Make ZPP-CRC32-Query frame
+///
+/// \param  address  First address
+/// \param  length   Number of bytes
+/// \return Frame
+constexpr Frame<10uz> make_zpp_crc32_query_frame(uint32_t address,
+                                                uint32_t length) {
+  Frame<10uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::ZppCrc32Query); // Command
+  it = uint32_2data(address, it);                     // Address
+  it = uint32_2data(length, it);                      // Length
+  *it = crc8({cbegin(frame), size(frame) - 1uz});     // CRC8
+  return frame;
+}
+
+/// Make Capabilities frame
+///
+/// \param  page     Page of capability bytes
+/// \return Frame
+constexpr Frame<3uz> make_capabilities_frame(uint8_t page = 0u) {
+  Frame<3uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::Capabilities); // Command
+  *it++ = page;                                      // Page
+  *it = crc8({cbegin(frame), size(frame) - 1uz});    // CRC8
+  return frame;
+}
+
+/// Make Features frame
+///
+/// \return Frame
+constexpr Frame<2uz> make_features_frame() {
+  Frame<2uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::Features);  // Command
+  *it = crc8({cbegin(frame), size(frame) - 1uz}); // CRC8
+  return frame;
+}
+
+/// Make Exit frame
+///
+/// \param  flags  Exit flags
+/// \return Frame
+constexpr Frame<5uz> make_exit_frame(uint8_t flags) {
+  Frame<5uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::Exit);      // Command
+  *it++ = 0x55u;                                  // Security byte
+  *it++ = 0xAAu;                                  // Security byte
+  *it++ = flags;                                  // Flags
+  *it = crc8({cbegin(frame), size(frame) - 1uz}); // CRC8
+  return frame;
+}
+
+/// Make ZPP LC DC Query frame
+///
+/// \param  developer_code  Developer code
+/// \return Frame
+constexpr Frame<6uz>
+make_zpp_lc_dc_query_frame(std::span<uint8_t const, 4uz> developer_code) {
+  Frame<6uz> frame{};
+  auto it{begin(frame)};
+  *it++ = std::to_underlying(Command::ZppLcDcQuery); // Command
+  it = std::ranges::copy(developer_code, it).out;    // Developer code
+  *it = crc8({cbegin(frame), size(frame) - 1uz});    // CRC8
+  return frame;
+}
+
+/// ZPP-Erase frame including CRC8
+inline constexpr auto zpp_erase_frame{make_zpp_erase_frame()};
+
+/// Features frame including CRC8
+inline constexpr auto features_frame{make_features_frame()};
+
+/// Make packet from frame
+///
+/// \param  frame  Frame
 /// \return Packet
-inline constexpr Packet make_cv_read_packet(uint8_t count, uint32_t address) {
+template<size_t N>
+requires(N <= ZUSI_MAX_PACKET_SIZE)
+constexpr Packet make_packet(Frame<N> const& frame) {
   Packet packet{};
-  auto it{std::back_inserter(packet)};
-  *it++ = std::to_underlying(Command::CvRead); // Command
-  *it++ = count;                               // Count
-  uint32_2data(address, it);                   // Address
-  *it++ = crc8(packet);                        // CRC8
+  std::ranges::copy(frame, std::back_inserter(packet));
   return packet;
 }
 
+/// Make CV-Read packet
+///
+/// \param  count    CV count - 1
+/// \param  address  First CV address
+/// \return Packet
+inline constexpr Packet make_cv_read_packet(uint8_t count, uint32_t address) {
+  return make_packet(make_cv_read_frame(count, address));
+}
+
 /// Make CV-Write packet
 ///
+/// \tparam F        CRC8 function
 /// \param  count    CV count - 1
 /// \param  address  First CV address
 /// \param  values   CV values
+/// \param  crc      CRC8 function
 /// \return Packet
-inline constexpr Packet make_cv_write_packet(uint8_t count,
-                                             uint32_t address,
-                                             std::span<uint8_t const> values) {
+template<typename F = Crc8>
+constexpr Packet make_cv_write_packet(uint8_t count,
+                                      uint32_t address,
+                                      std::span<uint8_t const> values,
+                                      F const& crc = {}) {
   // Count must match value list
-  assert((count - 1uz) == size(values));
+  assert(count + 1uz == size(values));
 
   Packet packet{};
   auto it{std::back_inserter(packet)};
@@ -118,7 +372,7 @@ inline constexpr Packet make_cv_write_packet(uint8_t count,
   *it++ = count;                                // Count
   uint32_2data(address, it);                    // Address
   std::ranges::copy(values, it);                // Values
-  *it++ = crc8(packet);                         // CRC8
+  *it++ = crc(packet);                          // CRC8
   return packet;
 }
 
@@ -126,71 +380,157 @@ inline constexpr Packet make_cv_write_packet(uint8_t count,
 ///
 /// \return Packet
 inline constexpr Packet make_zpp_erase_packet() {
-  Packet packet{};
-  auto it{std::back_inserter(packet)};
-  *it++ = std::to_underlying(Command::ZppErase); // Command
-  *it++ = 0x55u;                                 // Security byte
-  *it++ = 0xAAu;                                 // Security byte
-  *it++ = crc8(packet);                          // CRC8
-  return packet;
+  return make_packet(zpp_erase_frame);
+}
+
+/// Make ZPP-Erase-Range packet
+///
+/// \param  address  First address
+/// \param  length   Number of bytes
+/// \return Packet
+inline constexpr Packet make_zpp_erase_range_packet(uint32_t address,
+                                                    uint32_t length) {
+  return make_packet(make_zpp_erase_range_frame(address, length));
+}
+
+/// Make ZPP-Copy packet
+///
+/// \param  src     First source address
+/// \param  dst     First destination address
+/// \param  length  Number of bytes
+/// \return Packet
+inline constexpr Packet
+make_zpp_copy_packet(uint32_t src, uint32_t dst, uint32_t length) {
+  return make_packet(make_zpp_copy_frame(src, dst, length));
 }
 
 /// Make ZPP-Write packet
 ///
+/// \tparam F       CRC8 function
 /// \param  size    Chunk size - 1
 /// \param  address Chunk address
 /// \param  bytes   Chunk
+/// \param  crc     CRC8 function
 /// \return Packet
-inline constexpr Packet make_zpp_write_packet(uint8_t size,
-                                              uint32_t address,
-                                              std::span<uint8_t const> bytes) {
+template<typename F = Crc8>
+constexpr Packet make_zpp_write_packet(uint8_t size,
+                                       uint32_t address,
+                                       std::span<uint8_t const> bytes,
+                                       F const& crc = {}) {
   Packet packet{};
   auto it{std::back_inserter(packet)};
   *it++ = std::to_underlying(Command::ZppWrite); // Command
   *it++ = size;                                  // Size
   uint32_2data(address, it);                     // Address
   std::ranges::copy(bytes, it);                  // Flash data
-  *it++ = crc8(packet);                          // CRC8
+  *it++ = crc(packet);                           // CRC8
   return packet;
 }
 
-/// Make Features packet
+/// Make ZPP-Write-FEC packet
 ///
+/// Same as ZPP-Write apart from the command. The parity bytes have to be sent
+/// right after the packet (see make_zpp_write_fec_parity).
+///
+/// \tparam F       CRC8 function
+/// \param  size    Chunk size - 1
+/// \param  address Chunk address
+/// \param  bytes   Chunk
+/// \param  crc     CRC8 function
 /// \return Packet
-inline constexpr Packet make_features_packet() {
+template<typename F = Crc8>
+constexpr Packet make_zpp_write_fec_packet(uint8_t size,
+                                           uint32_t address,
+                                           std::span<uint8_t const> bytes,
+                                           F const& crc = {}) {
   Packet packet{};
   auto it{std::back_inserter(packet)};
-  *it++ = std::to_underlying(Command::Features); // Command
-  *it++ = crc8(packet);                          // CRC8
+  *it++ = std::to_underlying(Command::ZppWriteFec); // Command
+  *it++ = size;                                     // Size
+  uint32_2data(address, it);                        // Address
+  std::ranges::copy(bytes, it);                     // Flash data
+  *it++ = crc(packet);                              // CRC8
   return packet;
 }
 
-/// Make Exit packet
+/// Make ZPP-Write-FEC parity
 ///
-/// \param  option  Exit option
+/// Parity covers everything but the command byte, including the CRC8. The
+/// size byte is covered as well, but decoders need it before the parity
+/// arrives, so only the CRC8 catches errors there.
+///
+/// \param  packet    ZPP-Write-FEC packet
+/// \return FecParity Parity bytes
+constexpr FecParity
+make_zpp_write_fec_parity(std::span<uint8_t const> packet) {
+  return fec_encode(packet.subspan(data_cnt_pos));
+}
+
+/// Make ZPP-Write-Compressed packet
+///
+/// \tparam F          CRC8 function
+/// \param  address    Block address
+/// \param  compressed Compressed block
+/// \param  crc        CRC8 function
 /// \return Packet
-inline constexpr Packet make_exit_packet(uint8_t option) {
+template<typename F = Crc8>
+constexpr Packet
+make_zpp_write_compressed_packet(uint32_t address,
+                                 std::span<uint8_t const> compressed,
+                                 F const& crc = {}) {
+  assert(size(compressed) && size(compressed) <= 256uz);
+
   Packet packet{};
   auto it{std::back_inserter(packet)};
-  *it++ = std::to_underlying(Command::Exit); // Command
-  *it++ = 0x55u;                             // Security byte
-  *it++ = 0xAAu;                             // Security byte
-  *it++ = option;                            // Option
-  *it++ = crc8(packet);                      // CRC8
+  *it++ = std::to_underlying(Command::ZppWriteCompressed); // Command
+  *it++ = static_cast<uint8_t>(size(compressed) - 1uz);    // Size
+  uint32_2data(address, it);                               // Address
+  std::ranges::copy(compressed, it);                       // Compressed data
+  *it++ = crc(packet);                                     // CRC8
   return packet;
 }
 
+/// Make ZPP-CRC32-Query packet
+///
+/// \param  address  First address
+/// \param  length   Number of bytes
+/// \return Packet
+inline constexpr Packet make_zpp_crc32_query_packet(uint32_t address,
+                                                    uint32_t length) {
+  return make_packet(make_zpp_crc32_query_frame(address, length));
+}
+
+/// Make Capabilities packet
+///
+/// \param  page     Page of capability bytes
+/// \return Packet
+inline constexpr Packet make_capabilities_packet(uint8_t page = 0u) {
+  return make_packet(make_capabilities_frame(page));
+}
+
+/// Make Features packet
+///
+/// \return Packet
+inline constexpr Packet make_features_packet() {
+  return make_packet(features_frame);
+}
+
+/// Make Exit packet
+///
+/// \param  option  Exit option
+/// \return Packet
+inline constexpr Packet make_exit_packet(uint8_t option) {
+  return make_packet(make_exit_frame(option));
+}
+
 /// Make ZPP LC DC Query packet
 ///
 /// \param  developer_code  Developer code
 /// \return Packet
 inline constexpr Packet make_zpp_lc_dc_query_packet(uint32_t developer_code) {
-  Packet packet{};
-  auto it{std::back_inserter(packet)};
-  *it++ = std::to_underlying(Command::ZppLcDcQuery); // Command
-  uint32_2data(developer_code, it);                  // Developer Code
-  *it++ = crc8(packet);                              // CRC8
-  return packet;
+  std::array<uint8_t, 4uz> data{};
+  uint32_2data(developer_code, begin(data));
+  return make_packet(make_zpp_lc_dc_query_frame(data));
 }
 
 } // namespace zusi
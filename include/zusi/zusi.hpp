@@ -8,5 +8,21 @@
 /// \author Vincent Hamp
 /// \date   21/03/2023
 
+#include "capabilities.hpp"
+#include "fec.hpp"
 #include "rx/base.hpp"
+#include "rx/entry_detector.hpp"
+#include "rx/event_log.hpp"
+#include "rx/static_base.hpp"
+#include "rx/trace.hpp"
 #include "tx/base.hpp"
+#include "tx/command_phases.hpp"
+#include "tx/cv_backup.hpp"
+#include "tx/cv_cache.hpp"
+#include "tx/framed_image.hpp"
+#include "tx/static_base.hpp"
+#include "tx/timing.hpp"
+#include "tx/trace.hpp"
+#include "tx/zpp_dedup.hpp"
+#include "tx/zpp_journal.hpp"
+#include "tx/zpp_verify.hpp"
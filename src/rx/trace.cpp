@@ -0,0 +1,351 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Receive trace recording and replay
+///
+/// \file   rx/trace.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include "zusi.hpp"
+
+namespace zusi::rx {
+
+/// Ctor
+///
+/// \param  impl  Implementation to record
+/// \param  trace Trace to append to
+Recorder::Recorder(Base& impl, std::vector<uint8_t>& trace)
+  : _impl{impl}, _writer{trace}, _start{std::chrono::steady_clock::now()} {}
+
+#if ZUSI_RX_CV_READ
+/// Read CV
+uint8_t Recorder::readCv(uint32_t addr) const { return _impl.readCv(addr); }
+#endif
+
+#if ZUSI_RX_CV_WRITE
+/// Write CV
+void Recorder::writeCv(uint32_t addr, uint8_t byte) {
+  _impl.writeCv(addr, byte);
+}
+#endif
+
+#if ZUSI_RX_ZPP_ERASE
+/// Erase ZPP
+void Recorder::eraseZpp() { _impl.eraseZpp(); }
+#endif
+
+#if ZUSI_RX_ZPP_ERASE_RANGE
+/// Erase ZPP range
+void Recorder::eraseZppRange(uint32_t addr, uint32_t size) {
+  _impl.eraseZppRange(addr, size);
+}
+#endif
+
+#if ZUSI_RX_ZPP_COPY
+/// Copy ZPP range
+void Recorder::copyZpp(uint32_t src, uint32_t dst, uint32_t size) {
+  _impl.copyZpp(src, dst, size);
+}
+#endif
+
+#if ZUSI_RX_ZPP_CRC32_QUERY
+/// Calculate CRC32 of ZPP range
+uint32_t Recorder::crc32Zpp(uint32_t addr, uint32_t size) const {
+  return _impl.crc32Zpp(addr, size);
+}
+#endif
+
+#if ZUSI_RX_ZPP_WRITE && ZUSI_RX_CHUNK_SIZE
+/// Stage ZPP chunk
+void Recorder::stageZpp(uint32_t addr, std::span<uint8_t const> bytes) {
+  _impl.stageZpp(addr, bytes);
+}
+
+/// Commit staged ZPP chunks
+void Recorder::commitZpp() { _impl.commitZpp(); }
+
+/// Discard staged ZPP chunks
+void Recorder::discardZpp() { _impl.discardZpp(); }
+#elif ZUSI_RX_ZPP_WRITE
+/// Write ZPP
+void Recorder::writeZpp(uint32_t addr, std::span<uint8_t const> bytes) {
+  _impl.writeZpp(addr, bytes);
+}
+#endif
+
+/// Get features
+Features Recorder::features() const { return _impl.features(); }
+
+#if ZUSI_RX_CAPABILITIES
+/// Get capabilities
+Capabilities Recorder::capabilities() const {
+  return _impl.capabilities();
+}
+#endif
+
+/// Exit
+void Recorder::exit(uint8_t flags) { _impl.exit(flags); }
+
+#if ZUSI_RX_ZPP_LC_DC_QUERY
+/// Check if load code is valid
+bool Recorder::loadCodeValid(
+  std::span<uint8_t const, 4uz> developer_code) const {
+  return _impl.loadCodeValid(developer_code);
+}
+#endif
+
+#if ZUSI_RX_ZPP_ADDRESS
+/// Check if address is valid
+bool Recorder::addressValid(uint32_t addr) const {
+  return _impl.addressValid(addr);
+}
+#endif
+
+#if ZUSI_RX_EVENT_LOG_SIZE
+/// Get timestamp
+uint32_t Recorder::timestamp() const { return _impl.timestamp(); }
+#endif
+
+/// Receive byte
+std::optional<uint8_t> Recorder::receiveByte() const {
+  auto const byte{_impl.receiveByte()};
+  record({.type = trace::Type::ReceiveByte,
+          .state = static_cast<bool>(byte),
+          .bytes = byte ? std::span{&*byte, 1uz} : std::span<uint8_t const>{}});
+  return byte;
+}
+
+/// Wait for the clock to equal state
+bool Recorder::waitClock(bool state) const {
+  auto const retval{_impl.waitClock(state)};
+  record({.type = trace::Type::WaitClock, .state = state, .value = retval});
+  return retval;
+}
+
+/// Write data line
+void Recorder::writeData(bool state) const {
+  record({.type = trace::Type::WriteData, .state = state});
+  _impl.writeData(state);
+}
+
+/// Switch to SPI slave
+void Recorder::spiSlave() const {
+  record({.type = trace::Type::SpiSlave});
+  _impl.spiSlave();
+}
+
+/// Switch to GPIO output
+void Recorder::gpioOutput() const {
+  record({.type = trace::Type::GpioOutput});
+  _impl.gpioOutput();
+}
+
+/// Transmit bytes of response phase
+bool Recorder::transmitBytes(std::span<uint8_t const> bytes) const {
+  auto const retval{_impl.transmitBytes(bytes)};
+  record({.type = trace::Type::TransmitBytes, .state = retval, .bytes = bytes});
+  return retval;
+}
+
+/// Toggle front- and rear lights
+void Recorder::toggleLights() const { _impl.toggleLights(); }
+
+/// Accumulate CRC8 of bytes
+uint8_t Recorder::accumulateCrc8(std::span<uint8_t const> bytes,
+                                 uint8_t crc) const {
+  return _impl.accumulateCrc8(bytes, crc);
+}
+
+/// Append event with current time
+///
+/// \param  event Event
+void Recorder::record(trace::Event event) const {
+  event.time = std::chrono::steady_clock::now() - _start;
+  _writer.write(event);
+}
+
+/// Ctor
+///
+/// \param  impl  Implementation to feed
+/// \param  trace Trace
+Replayer::Replayer(Base& impl, std::span<uint8_t const> trace)
+  : _impl{impl}, _reader{trace} {}
+
+/// Replay whole trace
+///
+/// \retval size_t        Index of first event which did not match
+/// \retval std::nullopt  Replay matched trace
+std::optional<size_t> Replayer::run() {
+  while (!_end && !_mismatch) receive();
+  return _mismatch;
+}
+
+#if ZUSI_RX_CV_READ
+/// Read CV
+uint8_t Replayer::readCv(uint32_t addr) const { return _impl.readCv(addr); }
+#endif
+
+#if ZUSI_RX_CV_WRITE
+/// Write CV
+void Replayer::writeCv(uint32_t addr, uint8_t byte) {
+  _impl.writeCv(addr, byte);
+}
+#endif
+
+#if ZUSI_RX_ZPP_ERASE
+/// Erase ZPP
+void Replayer::eraseZpp() { _impl.eraseZpp(); }
+#endif
+
+#if ZUSI_RX_ZPP_ERASE_RANGE
+/// Erase ZPP range
+void Replayer::eraseZppRange(uint32_t addr, uint32_t size) {
+  _impl.eraseZppRange(addr, size);
+}
+#endif
+
+#if ZUSI_RX_ZPP_COPY
+/// Copy ZPP range
+void Replayer::copyZpp(uint32_t src, uint32_t dst, uint32_t size) {
+  _impl.copyZpp(src, dst, size);
+}
+#endif
+
+#if ZUSI_RX_ZPP_CRC32_QUERY
+/// Calculate CRC32 of ZPP range
+uint32_t Replayer::crc32Zpp(uint32_t addr, uint32_t size) const {
+  return _impl.crc32Zpp(addr, size);
+}
+#endif
+
+#if ZUSI_RX_ZPP_WRITE && ZUSI_RX_CHUNK_SIZE
+/// Stage ZPP chunk
+void Replayer::stageZpp(uint32_t addr, std::span<uint8_t const> bytes) {
+  _impl.stageZpp(addr, bytes);
+}
+
+/// Commit staged ZPP chunks
+void Replayer::commitZpp() { _impl.commitZpp(); }
+
+/// Discard staged ZPP chunks
+void Replayer::discardZpp() { _impl.discardZpp(); }
+#elif ZUSI_RX_ZPP_WRITE
+/// Write ZPP
+void Replayer::writeZpp(uint32_t addr, std::span<uint8_t const> bytes) {
+  _impl.writeZpp(addr, bytes);
+}
+#endif
+
+/// Get features
+Features Replayer::features() const { return _impl.features(); }
+
+#if ZUSI_RX_CAPABILITIES
+/// Get capabilities
+Capabilities Replayer::capabilities() const {
+  return _impl.capabilities();
+}
+#endif
+
+/// Exit
+void Replayer::exit(uint8_t flags) { _impl.exit(flags); }
+
+#if ZUSI_RX_ZPP_LC_DC_QUERY
+/// Check if load code is valid
+bool Replayer::loadCodeValid(
+  std::span<uint8_t const, 4uz> developer_code) const {
+  return _impl.loadCodeValid(developer_code);
+}
+#endif
+
+#if ZUSI_RX_ZPP_ADDRESS
+/// Check if address is valid
+bool Replayer::addressValid(uint32_t addr) const {
+  return _impl.addressValid(addr);
+}
+#endif
+
+#if ZUSI_RX_EVENT_LOG_SIZE
+/// Get timestamp
+uint32_t Replayer::timestamp() const { return _impl.timestamp(); }
+#endif
+
+/// Receive byte
+std::optional<uint8_t> Replayer::receiveByte() const {
+  auto const event{expect({.type = trace::Type::ReceiveByte})};
+  if (!event || !event->state) return std::nullopt;
+  return event->bytes.front();
+}
+
+/// Wait for the clock to equal state
+bool Replayer::waitClock(bool state) const {
+  auto const event{expect({.type = trace::Type::WaitClock, .state = state})};
+  return event && event->value;
+}
+
+/// Write data line
+void Replayer::writeData(bool state) const {
+  expect({.type = trace::Type::WriteData, .state = state});
+}
+
+/// Switch to SPI slave
+void Replayer::spiSlave() const { expect({.type = trace::Type::SpiSlave}); }
+
+/// Switch to GPIO output
+void Replayer::gpioOutput() const {
+  expect({.type = trace::Type::GpioOutput});
+}
+
+/// Transmit bytes of response phase
+bool Replayer::transmitBytes(std::span<uint8_t const> bytes) const {
+  auto const event{
+    expect({.type = trace::Type::TransmitBytes, .bytes = bytes})};
+  return event && event->state;
+}
+
+/// Toggle front- and rear lights
+void Replayer::toggleLights() const { _impl.toggleLights(); }
+
+/// Accumulate CRC8 of bytes
+uint8_t Replayer::accumulateCrc8(std::span<uint8_t const> bytes,
+                                 uint8_t crc) const {
+  return _impl.accumulateCrc8(bytes, crc);
+}
+
+/// Compare event with next one in trace
+///
+/// Inputs are only compared by type and requested state or transmitted bytes,
+/// their result gets taken from the trace.
+///
+/// \param  event         Expected event
+/// \retval trace::Event  Recorded event
+/// \retval std::nullopt  End of trace or mismatch
+std::optional<trace::Event> Replayer::expect(trace::Event const& event) const {
+  if (_end || _mismatch) return std::nullopt;
+  auto const recorded{_reader.next()};
+  if (!recorded) {
+    if (_reader.error()) _mismatch = _index;
+    _end = true;
+    return std::nullopt;
+  }
+  auto matches{recorded->type == event.type};
+  switch (event.type) {
+    case trace::Type::ReceiveByte: break;
+    case trace::Type::WaitClock:
+      matches = matches && recorded->state == event.state;
+      break;
+    case trace::Type::TransmitBytes:
+      matches = matches && std::ranges::equal(recorded->bytes, event.bytes);
+      break;
+    default: matches = matches && recorded->equivalent(event); break;
+  }
+  if (!matches) {
+    _mismatch = _index;
+    return std::nullopt;
+  }
+  ++_index;
+  return recorded;
+}
+
+} // namespace zusi::rx
@@ -0,0 +1,182 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Bus trace
+///
+/// \file   trace.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include "trace.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace zusi::trace {
+
+namespace {
+
+// Tag byte layout
+constexpr uint8_t type_mask{0x0Fu};
+constexpr uint8_t state_bit{0x10u};
+constexpr uint8_t mbps_shift{5u};
+constexpr uint8_t mbps_mask{0x03u};
+
+} // namespace
+
+/// Compare everything except timing
+///
+/// \param  other Other event
+/// \retval true  Events are equivalent
+/// \retval false Events differ
+bool Event::equivalent(Event const& other) const {
+  if (type != other.type || state != other.state) return false;
+  switch (type) {
+    case Type::TransmitBytes: [[fallthrough]];
+    case Type::ReceiveBytes:
+      return mbps == other.mbps && std::ranges::equal(bytes, other.bytes);
+    case Type::ReceiveByte: return std::ranges::equal(bytes, other.bytes);
+    case Type::WaitClock: [[fallthrough]];
+    case Type::DelayUs: return value == other.value;
+    default: return true;
+  }
+}
+
+/// Ctor
+///
+/// \param  trace Trace to append to
+Writer::Writer(std::vector<uint8_t>& trace) : _trace{trace} {
+  if (empty(_trace)) std::ranges::copy(magic, std::back_inserter(_trace));
+}
+
+/// Append event
+///
+/// \param  event Event
+void Writer::write(Event const& event) {
+  _trace.push_back(
+    static_cast<uint8_t>(std::to_underlying(event.type) |
+                         (event.state ? state_bit : 0u) |
+                         std::to_underlying(event.mbps) << mbps_shift));
+  leb128(static_cast<uint64_t>(std::max(event.time - _time, {}).count()));
+  _time = std::max(event.time, _time);
+  switch (event.type) {
+    case Type::TransmitBytes: [[fallthrough]];
+    case Type::ReceiveBytes:
+      leb128(size(event.bytes));
+      std::ranges::copy(event.bytes, std::back_inserter(_trace));
+      break;
+    case Type::ReceiveByte:
+      if (event.state) _trace.push_back(event.bytes.front());
+      break;
+    case Type::WaitClock: [[fallthrough]];
+    case Type::DelayUs: [[fallthrough]];
+    case Type::Busy: leb128(event.value); break;
+    default: break;
+  }
+}
+
+/// Append LEB128 encoded value
+///
+/// \param  value Value
+void Writer::leb128(uint64_t value) {
+  do {
+    auto const byte{static_cast<uint8_t>(value & 0x7Fu)};
+    value >>= 7u;
+    _trace.push_back(value ? byte | 0x80u : byte);
+  } while (value);
+}
+
+/// Ctor
+///
+/// \param  trace Trace
+Reader::Reader(std::span<uint8_t const> trace) : _trace{trace} {
+  if (size(_trace) < size(magic) ||
+      !std::ranges::equal(_trace.first<size(magic)>(), magic))
+    _error = true;
+  else _pos = size(magic);
+}
+
+/// Decode next event
+///
+/// \retval Event         Next event
+/// \retval std::nullopt  End of trace or malformed trace
+std::optional<Event> Reader::next() {
+  if (_error || _pos >= size(_trace)) return std::nullopt;
+  auto const tag{_trace[_pos++]};
+  if ((tag & type_mask) > std::to_underlying(Type::ReceiveBytes)) {
+    _error = true;
+    return std::nullopt;
+  }
+  Event event{.type = static_cast<Type>(tag & type_mask),
+              .state = static_cast<bool>(tag & state_bit),
+              .mbps = static_cast<Mbps>(tag >> mbps_shift & mbps_mask)};
+  auto const delta{leb128()};
+  if (!delta) return std::nullopt;
+  _time += std::chrono::nanoseconds{*delta};
+  event.time = _time;
+  switch (event.type) {
+    case Type::TransmitBytes: [[fallthrough]];
+    case Type::ReceiveBytes: {
+      auto const count{leb128()};
+      if (!count) return std::nullopt;
+      if (*count > size(_trace) - _pos) {
+        _error = true;
+        return std::nullopt;
+      }
+      event.bytes = _trace.subspan(_pos, *count);
+      _pos += *count;
+      break;
+    }
+    case Type::ReceiveByte:
+      if (!event.state) break;
+      if (_pos >= size(_trace)) {
+        _error = true;
+        return std::nullopt;
+      }
+      event.bytes = _trace.subspan(_pos++, 1uz);
+      break;
+    case Type::WaitClock: [[fallthrough]];
+    case Type::DelayUs: [[fallthrough]];
+    case Type::Busy:
+      if (auto const value{leb128()})
+        event.value = static_cast<uint32_t>(*value);
+      else return std::nullopt;
+      break;
+    default: break;
+  }
+  return event;
+}
+
+/// Decode LEB128 encoded value
+///
+/// \retval uint64_t      Value
+/// \retval std::nullopt  Malformed trace
+std::optional<uint64_t> Reader::leb128() {
+  uint64_t value{};
+  for (auto shift{0u}; _pos < size(_trace) && shift < 64u; shift += 7u) {
+    auto const byte{_trace[_pos++]};
+    value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+    if (!(byte & 0x80u)) return value;
+  }
+  _error = true;
+  return std::nullopt;
+}
+
+/// Find the first event in which two traces differ, ignoring timing
+///
+/// \param  a             Trace
+/// \param  b             Trace
+/// \retval size_t        Index of first differing event
+/// \retval std::nullopt  Traces are equivalent
+std::optional<size_t> first_mismatch(std::span<uint8_t const> a,
+                                     std::span<uint8_t const> b) {
+  Reader ra{a}, rb{b};
+  for (auto i{0uz};; ++i) {
+    auto const ea{ra.next()}, eb{rb.next()};
+    if (ra.error() || rb.error()) return i;
+    if (!ea && !eb) return std::nullopt;
+    if (!ea || !eb || !ea->equivalent(*eb)) return i;
+  }
+}
+
+} // namespace zusi::trace
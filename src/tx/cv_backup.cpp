@@ -0,0 +1,143 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// CV backup and restore
+///
+/// \file   tx/cv_backup.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include <algorithm>
+#include <numeric>
+#include "crc32.hpp"
+#include "zusi.hpp"
+
+namespace zusi::tx {
+
+namespace {
+
+/// Size of magic, address and count
+constexpr size_t header_size{size(cv_snapshot_magic) + 4uz + 2uz};
+
+/// Size of CRC32
+constexpr size_t crc_size{4uz};
+
+/// Read all CVs of a range into a new cache
+///
+/// \param  base                        Transmit base
+/// \param  addr                        First CV address
+/// \param  count                       Number of CVs
+/// \param  max_count                   Maximum number of CVs per frame
+/// \retval CvCache                     CV cache
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Range out of CV address space
+std::expected<CvCache, std::errc>
+read_range(Base& base, uint32_t addr, size_t count, size_t max_count) {
+  if (addr + count > CvCache::cv_count)
+    return std::unexpected{std::errc::invalid_argument};
+  std::vector<uint32_t> addrs(count);
+  std::iota(begin(addrs), end(addrs), addr);
+  CvCache cache{base, CvCache::Policy::WriteBack, max_count};
+  if (auto const result{cache.prefetch(addrs)}; !result)
+    return std::unexpected{result.error()};
+  return cache;
+}
+
+} // namespace
+
+/// Read a range of CVs
+///
+/// \param  base                        Transmit base
+/// \param  addr                        First CV address
+/// \param  count                       Number of CVs
+/// \param  max_count                   Maximum number of CVs per frame
+/// \retval CvSnapshot                  Snapshot
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Range out of CV address space
+std::expected<CvSnapshot, std::errc>
+backup_cvs(Base& base, uint32_t addr, size_t count, size_t max_count) {
+  auto const cache{read_range(base, addr, count, max_count)};
+  if (!cache) return std::unexpected{cache.error()};
+  CvSnapshot snapshot{.addr = addr, .values = std::vector<uint8_t>(count)};
+  for (auto i{0uz}; i < count; ++i)
+    snapshot.values[i] = *cache->peek(static_cast<uint32_t>(addr + i));
+  return snapshot;
+}
+
+/// Write all CVs which differ from snapshot
+///
+/// \param  base                        Transmit base
+/// \param  snapshot                    Snapshot
+/// \param  max_count                   Maximum number of CVs per frame
+/// \retval size_t                      Number of CVs written
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Range out of CV address space
+std::expected<size_t, std::errc>
+restore_cvs(Base& base, CvSnapshot const& snapshot, size_t max_count) {
+  auto const count{size(snapshot.values)};
+  auto cache{read_range(base, snapshot.addr, count, max_count)};
+  if (!cache) return std::unexpected{cache.error()};
+  size_t written{};
+  for (auto i{0uz}; i < count; ++i) {
+    auto const addr{static_cast<uint32_t>(snapshot.addr + i)};
+    if (cache->peek(addr) == snapshot.values[i]) continue;
+    cache->writeCv(addr, snapshot.values[i]);
+    ++written;
+  }
+  if (auto const result{cache->flush()}; !result)
+    return std::unexpected{result.error()};
+  return written;
+}
+
+/// Serialize snapshot
+///
+/// The format consists of magic, big-endian address and count, the CV values
+/// and a big-endian CRC32 over everything before.
+///
+/// \param  snapshot  Snapshot
+/// \return Serialized snapshot
+std::vector<uint8_t> serialize_cv_snapshot(CvSnapshot const& snapshot) {
+  auto const count{size(snapshot.values)};
+  std::vector<uint8_t> bytes;
+  bytes.reserve(header_size + count + crc_size);
+  auto it{std::back_inserter(bytes)};
+  it = std::ranges::copy(cv_snapshot_magic, it).out;
+  it = uint32_2data(snapshot.addr, it);
+  *it++ = static_cast<uint8_t>(count >> 8u);
+  *it++ = static_cast<uint8_t>(count);
+  it = std::ranges::copy(snapshot.values, it).out;
+  uint32_2data(crc32(bytes), it);
+  return bytes;
+}
+
+/// Deserialize snapshot
+///
+/// \param  bytes                       Serialized snapshot
+/// \retval CvSnapshot                  Snapshot
+/// \retval std::errc::invalid_argument Wrong magic or size
+/// \retval std::errc::bad_message      CRC error
+std::expected<CvSnapshot, std::errc>
+deserialize_cv_snapshot(std::span<uint8_t const> bytes) {
+  if (size(bytes) < header_size + crc_size ||
+      !std::ranges::equal(bytes.first<size(cv_snapshot_magic)>(),
+                          cv_snapshot_magic))
+    return std::unexpected{std::errc::invalid_argument};
+  size_t const count{static_cast<size_t>(bytes[8uz] << 8u | bytes[9uz])};
+  if (size(bytes) != header_size + count + crc_size)
+    return std::unexpected{std::errc::invalid_argument};
+  auto const payload{bytes.first(header_size + count)};
+  if (crc32(payload) != data2uint32(&bytes[size(payload)]))
+    return std::unexpected{std::errc::bad_message};
+  return CvSnapshot{
+    .addr = data2uint32(&bytes[size(cv_snapshot_magic)]),
+    .values = {cbegin(payload) + header_size, cend(payload)}};
+}
+
+} // namespace zusi::tx
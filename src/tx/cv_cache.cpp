@@ -0,0 +1,210 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// CV cache
+///
+/// \file   tx/cv_cache.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include <algorithm>
+#include <gsl/util>
+#include "zusi.hpp"
+
+namespace zusi::tx {
+
+namespace {
+
+/// Call f for every contiguous run of set bits
+///
+/// \tparam N         Number of bits
+/// \tparam F         Callable taking address and count
+/// \param  bits      Bits
+/// \param  max_count Maximum length of a run
+/// \param  f         Callable
+/// \return Result of the first failing call or true
+template<size_t N, typename F>
+std::expected<bool, std::errc>
+for_each_run(std::bitset<N> const& bits, size_t max_count, F&& f) {
+  for (auto i{0uz}; i < N;) {
+    if (!bits[i]) {
+      ++i;
+      continue;
+    }
+    auto j{i + 1uz};
+    while (j < N && j - i < max_count && bits[j]) ++j;
+    if (auto const result{f(static_cast<uint32_t>(i), j - i)}; !result)
+      return result;
+    i = j;
+  }
+  return true;
+}
+
+} // namespace
+
+/// Ctor
+///
+/// \param  base      Transmit base
+/// \param  policy    Write policy
+/// \param  max_count Maximum number of CVs per frame
+CvCache::CvCache(Base& base, Policy policy, size_t max_count)
+  : _base{base}, _policy{policy},
+    _max_count{std::clamp(max_count, 1uz, 256uz)} {}
+
+/// Transmit entry sequence and invalidate cache
+void CvCache::enter() {
+  invalidate();
+  _base.enter();
+}
+
+/// Transmit fast entry sequence with fallback and invalidate cache
+///
+/// \param  homogeneous                 All devices detect fast entry
+/// \retval Features                    Feature bytes
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+std::expected<Features, std::errc> CvCache::enterFast(bool homogeneous) {
+  invalidate();
+  return _base.enterFast(homogeneous);
+}
+
+/// Flush cache, exit and invalidate cache
+///
+/// \param  flags                       Flags
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+std::expected<bool, std::errc> CvCache::exit(uint8_t flags) {
+  if (auto const result{flush()}; !result) return result;
+  gsl::final_action invalidate_cache{[this] { invalidate(); }};
+  return _base.exit(flags);
+}
+
+/// Read CV
+///
+/// \param  addr                        CV address
+/// \retval uint8_t                     CV value
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+std::expected<uint8_t, std::errc> CvCache::readCv(uint32_t addr) {
+  if (addr >= cv_count) return _base.readCv(addr);
+  if (!_valid[addr])
+    if (auto const result{read(addr, 1uz)}; !result)
+      return std::unexpected{result.error()};
+  return _values[addr];
+}
+
+/// Write CV
+///
+/// Writes are always sent, even if the value is already known. Writing a CV
+/// can be an action on its own (e.g. reset with CV8).
+///
+/// \param  addr                        CV address
+/// \param  byte                        CV value
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+std::expected<bool, std::errc> CvCache::writeCv(uint32_t addr, uint8_t byte) {
+  if (addr >= cv_count) return _base.writeCv(addr, byte);
+  _values[addr] = byte;
+  _valid.set(addr);
+  _dirty.set(addr);
+  if (_policy == Policy::WriteBack) return true;
+  auto const result{write(addr, 1uz)};
+  // Value on decoder is unknown after a failed write
+  if (!result) {
+    _valid.reset(addr);
+    _dirty.reset(addr);
+  }
+  return result;
+}
+
+/// Read all CVs not yet known
+///
+/// \param  addrs                       CV addresses
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+/// \retval std::errc::invalid_argument Address out of range
+std::expected<bool, std::errc>
+CvCache::prefetch(std::span<uint32_t const> addrs) {
+  std::bitset<cv_count> missing{};
+  for (auto const addr : addrs)
+    if (addr >= cv_count) return std::unexpected{std::errc::invalid_argument};
+    else missing.set(addr, !_valid[addr]);
+  return for_each_run(missing, _max_count, [this](uint32_t addr, size_t count) {
+    return read(addr, count);
+  });
+}
+
+/// Write all dirty CVs
+///
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+std::expected<bool, std::errc> CvCache::flush() {
+  return for_each_run(_dirty, _max_count, [this](uint32_t addr, size_t count) {
+    return write(addr, count);
+  });
+}
+
+/// Forget all CV values, including dirty ones
+void CvCache::invalidate() {
+  _valid.reset();
+  _dirty.reset();
+}
+
+/// Get cached CV value
+///
+/// \param  addr          CV address
+/// \retval uint8_t       CV value
+/// \retval std::nullopt  CV value unknown
+std::optional<uint8_t> CvCache::peek(uint32_t addr) const {
+  if (addr >= cv_count || !_valid[addr]) return std::nullopt;
+  return _values[addr];
+}
+
+/// Check if CV has not yet been written
+///
+/// \param  addr  CV address
+/// \retval true  CV is dirty
+/// \retval false CV is clean
+bool CvCache::dirty(uint32_t addr) const {
+  return addr < cv_count && _dirty[addr];
+}
+
+/// Read range of CVs into cache
+///
+/// \param  addr                        First CV address
+/// \param  count                       Number of CVs
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+std::expected<bool, std::errc> CvCache::read(uint32_t addr, size_t count) {
+  std::array<uint8_t, 256uz> bytes{};
+  auto const result{_base.readCv(addr, {begin(bytes), count})};
+  if (!result) return result;
+  std::copy_n(cbegin(bytes), count, begin(_values) + addr);
+  for (auto i{addr}; i < addr + count; ++i) _valid.set(i);
+  return true;
+}
+
+/// Write range of CVs from cache
+///
+/// \param  addr                        First CV address
+/// \param  count                       Number of CVs
+/// \retval true                        Success
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+std::expected<bool, std::errc> CvCache::write(uint32_t addr, size_t count) {
+  auto const result{_base.writeCv(addr, {cbegin(_values) + addr, count})};
+  if (!result) return result;
+  for (auto i{addr}; i < addr + count; ++i) _dirty.reset(i);
+  return true;
+}
+
+} // namespace zusi::tx
@@ -0,0 +1,86 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Pre-framed ZPP image
+///
+/// \file   tx/framed_image.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <utility>
+#include "zusi.hpp"
+
+namespace zusi::tx {
+
+namespace {
+
+/// Size of a block
+constexpr size_t block_size{256uz};
+
+} // namespace
+
+/// Ctor
+///
+/// Blocks get framed twice. The first pass only determines the size of every
+/// packet, the second one frames them straight into their place in the arena.
+/// This keeps the peak memory close to the size of the arena itself.
+///
+/// \param  addr      Address of first block
+/// \param  bytes     Image
+/// \param  compress  Compress blocks which get smaller
+/// \param  for_each  Function to call for every block
+FramedImage::FramedImage(uint32_t addr,
+                         std::span<uint8_t const> bytes,
+                         bool compress,
+                         ForEach const& for_each) {
+  auto const blocks{(std::size(bytes) + block_size - 1uz) / block_size};
+  auto const parallel{[&](std::function<void(size_t)> const& f) {
+    if (for_each) for_each(blocks, f);
+    else
+      for (auto i{0uz}; i < blocks; ++i) f(i);
+  }};
+
+  auto const frame{[&](size_t i) {
+    auto const block{bytes.subspan(
+      i * block_size, std::min(block_size, std::size(bytes) - i * block_size))};
+    auto const block_addr{static_cast<uint32_t>(addr + i * block_size)};
+    std::array<uint8_t, compression_window> compressed;
+    auto const count{
+      compress && std::size(block) > 1uz
+        ? zusi::compress(block,
+                         std::span{compressed}.first(std::size(block) - 1uz))
+        : 0uz};
+    return count ? make_zpp_write_compressed_packet(
+                     block_addr, std::span{compressed}.first(count))
+                 : make_zpp_write_packet(
+                     static_cast<uint8_t>(std::size(block) - 1uz),
+                     block_addr,
+                     block);
+  }};
+
+  // Sizes are stored shifted by one, so the prefix sum yields the offsets
+  _offsets.resize(blocks + 1uz);
+  parallel([&](size_t i) {
+    _offsets[i + 1uz] = static_cast<uint32_t>(std::size(frame(i)));
+  });
+  for (auto i{0uz}; i < blocks; ++i) _offsets[i + 1uz] += _offsets[i];
+
+  _arena.resize(_offsets.back());
+  parallel(
+    [&](size_t i) { std::ranges::copy(frame(i), &_arena[_offsets[i]]); });
+}
+
+/// Check if packet is compressed
+///
+/// \param  i     Index
+/// \retval true  Packet is ZPP-Write-Compressed
+/// \retval false Packet is ZPP-Write
+bool FramedImage::compressed(size_t i) const {
+  return _arena[_offsets[i]] == std::to_underlying(Command::ZppWriteCompressed);
+}
+
+} // namespace zusi::tx
@@ -0,0 +1,195 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Transmit trace recording and replay
+///
+/// \file   tx/trace.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include "zusi.hpp"
+
+namespace zusi::tx {
+
+/// Ctor
+///
+/// \param  impl  Implementation to record
+/// \param  trace Trace to append to
+Recorder::Recorder(Base& impl, std::vector<uint8_t>& trace)
+  : _impl{impl}, _writer{trace}, _start{std::chrono::steady_clock::now()} {}
+
+/// Transmit bytes
+void Recorder::transmitBytes(std::span<uint8_t const> bytes, Mbps mbps) const {
+  record({.type = trace::Type::TransmitBytes, .mbps = mbps, .bytes = bytes});
+  _impl.transmitBytes(bytes, mbps);
+}
+
+/// Switch to SPI master
+void Recorder::spiMaster() const {
+  record({.type = trace::Type::SpiMaster});
+  _impl.spiMaster();
+}
+
+/// Switch to GPIO input
+void Recorder::gpioInput() const {
+  record({.type = trace::Type::GpioInput});
+  _impl.gpioInput();
+}
+
+/// Switch to GPIO output
+void Recorder::gpioOutput() const {
+  record({.type = trace::Type::GpioOutput});
+  _impl.gpioOutput();
+}
+
+/// Write clock line
+void Recorder::writeClock(bool state) const {
+  record({.type = trace::Type::WriteClock, .state = state});
+  _impl.writeClock(state);
+}
+
+/// Write data line
+void Recorder::writeData(bool state) const {
+  record({.type = trace::Type::WriteData, .state = state});
+  _impl.writeData(state);
+}
+
+/// Read data line
+bool Recorder::readData() const {
+  auto const state{_impl.readData()};
+  record({.type = trace::Type::ReadData, .state = state});
+  return state;
+}
+
+/// Delay microseconds
+void Recorder::delayUs(uint32_t us) const {
+  record({.type = trace::Type::DelayUs, .value = us});
+  _impl.delayUs(us);
+}
+
+/// Receive bytes of response phase
+void Recorder::receiveBytes(std::span<uint8_t> bytes, Mbps mbps) const {
+  _impl.receiveBytes(bytes, mbps);
+  record({.type = trace::Type::ReceiveBytes, .mbps = mbps, .bytes = bytes});
+}
+
+/// Busy phase
+void Recorder::busy() const {
+  auto const then{std::chrono::steady_clock::now()};
+  _impl.busy();
+  auto const us{std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - then)};
+  record(
+    {.type = trace::Type::Busy, .value = static_cast<uint32_t>(us.count())});
+}
+
+/// Accumulate CRC8
+///
+/// \note
+/// Not recorded, the CRC unit is no bus access.
+uint8_t Recorder::accumulateCrc8(std::span<uint8_t const> bytes,
+                                 uint8_t crc) const {
+  return _impl.accumulateCrc8(bytes, crc);
+}
+
+/// Append event with current time
+///
+/// \param  event Event
+void Recorder::record(trace::Event event) const {
+  event.time = std::chrono::steady_clock::now() - _start;
+  _writer.write(event);
+}
+
+/// Ctor
+///
+/// \param  trace Trace
+Replayer::Replayer(std::span<uint8_t const> trace) : _reader{trace} {}
+
+/// Check if all events have been replayed
+///
+/// \retval true  All events replayed
+/// \retval false Events left
+bool Replayer::done() const {
+  auto reader{_reader};
+  return !reader.next() && !reader.error();
+}
+
+/// Transmit bytes
+void Replayer::transmitBytes(std::span<uint8_t const> bytes, Mbps mbps) const {
+  expect({.type = trace::Type::TransmitBytes, .mbps = mbps, .bytes = bytes});
+}
+
+/// Switch to SPI master
+void Replayer::spiMaster() const { expect({.type = trace::Type::SpiMaster}); }
+
+/// Switch to GPIO input
+void Replayer::gpioInput() const { expect({.type = trace::Type::GpioInput}); }
+
+/// Switch to GPIO output
+void Replayer::gpioOutput() const {
+  expect({.type = trace::Type::GpioOutput});
+}
+
+/// Write clock line
+void Replayer::writeClock(bool state) const {
+  expect({.type = trace::Type::WriteClock, .state = state});
+}
+
+/// Write data line
+void Replayer::writeData(bool state) const {
+  expect({.type = trace::Type::WriteData, .state = state});
+}
+
+/// Read data line
+///
+/// \note
+/// Once replay diverged the data line reads high, which aborts with
+/// std::errc::connection_reset at the next ACK phase.
+bool Replayer::readData() const {
+  auto const event{expect({.type = trace::Type::ReadData})};
+  return event ? event->state : true;
+}
+
+/// Delay microseconds
+void Replayer::delayUs(uint32_t us) const {
+  expect({.type = trace::Type::DelayUs, .value = us});
+}
+
+/// Receive bytes of response phase
+///
+/// \note
+/// Once replay diverged all bytes read 0xFF, which fails the CRC check.
+void Replayer::receiveBytes(std::span<uint8_t> bytes, Mbps mbps) const {
+  auto const event{expect({.type = trace::Type::ReceiveBytes, .mbps = mbps})};
+  if (event && size(event->bytes) == size(bytes))
+    std::ranges::copy(event->bytes, begin(bytes));
+  else std::ranges::fill(bytes, 0xFFu);
+}
+
+/// Busy phase
+void Replayer::busy() const { expect({.type = trace::Type::Busy}); }
+
+/// Compare event with next one in trace
+///
+/// Inputs are only compared by type, their state gets taken from the trace.
+///
+/// \param  event         Expected event
+/// \retval trace::Event  Recorded event
+/// \retval std::nullopt  Mismatch
+std::optional<trace::Event> Replayer::expect(trace::Event const& event) const {
+  if (_mismatch) return std::nullopt;
+  auto const recorded{_reader.next()};
+  auto const input{event.type == trace::Type::ReadData ||
+                   event.type == trace::Type::ReceiveBytes ||
+                   event.type == trace::Type::Busy};
+  if (!recorded || recorded->type != event.type ||
+      (!input && !recorded->equivalent(event))) {
+    _mismatch = _index;
+    return std::nullopt;
+  }
+  ++_index;
+  return recorded;
+}
+
+} // namespace zusi::tx
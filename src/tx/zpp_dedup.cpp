@@ -0,0 +1,54 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// ZPP deduplication
+///
+/// \file   tx/zpp_dedup.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include <algorithm>
+#include <unordered_map>
+#include "zusi.hpp"
+
+namespace zusi::tx {
+
+/// Find blocks which repeat earlier content
+///
+/// \param  addr                  First address
+/// \param  bytes                 Image
+/// \param  block_size            Size of a block
+/// \return std::vector<ZppCopy>  Copies sorted by destination
+std::vector<ZppCopy> find_duplicate_blocks(uint32_t addr,
+                                           std::span<uint8_t const> bytes,
+                                           size_t block_size) {
+  std::vector<ZppCopy> copies;
+  if (!block_size) return copies;
+  auto const blocks{size(bytes) / block_size};
+  auto const block{
+    [&](size_t i) { return bytes.subspan(i * block_size, block_size); }};
+
+  // Hash of block to indices of first occurrences
+  std::unordered_multimap<uint32_t, size_t> firsts;
+  for (auto i{0uz}; i < blocks; ++i) {
+    auto const hash{crc32(block(i))};
+    auto const [first, last]{firsts.equal_range(hash)};
+    auto const it{std::find_if(first, last, [&](auto const& kv) {
+      return std::ranges::equal(block(kv.second), block(i));
+    })};
+    if (it == last) {
+      firsts.emplace(hash, i);
+      continue;
+    }
+    auto const src{static_cast<uint32_t>(addr + it->second * block_size)};
+    auto const dst{static_cast<uint32_t>(addr + i * block_size)};
+    if (!empty(copies) && copies.back().src + copies.back().size == src &&
+        copies.back().dst + copies.back().size == dst)
+      copies.back().size += block_size;
+    else copies.push_back({.src = src, .dst = dst, .size = block_size});
+  }
+  return copies;
+}
+
+} // namespace zusi::tx
@@ -0,0 +1,99 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Resumable ZPP update journal
+///
+/// \file   tx/zpp_journal.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include <algorithm>
+#include "zusi.hpp"
+
+namespace zusi::tx {
+
+namespace {
+
+/// Size of header including CRC8
+///
+/// Magic, image CRC32 and size, features, developer code, load code valid and
+/// CRC8.
+constexpr size_t header_size{size(zpp_journal_magic) + 4uz + 4uz +
+                             size(Features{}) + 4uz + 1uz + 1uz};
+
+/// Size of record including CRC8
+constexpr size_t record_size{4uz + 1uz};
+
+} // namespace
+
+/// Ctor
+///
+/// \param  append  Append function
+/// \param  session Session
+ZppJournal::ZppJournal(Append append, ZppSession const& session)
+  : _append{std::move(append)} {
+  std::array<uint8_t, header_size> header{};
+  auto it{std::ranges::copy(zpp_journal_magic, begin(header)).out};
+  it = uint32_2data(session.image_crc, it);
+  it = uint32_2data(session.image_size, it);
+  it = std::ranges::copy(session.features, it).out;
+  it = std::ranges::copy(session.developer_code, it).out;
+  *it++ = session.load_code_valid;
+  *it = crc8({cbegin(header), header_size - 1uz});
+  _append(header);
+}
+
+/// Record that all data up to addr has been acknowledged
+///
+/// \param  addr  Address past the last acknowledged byte
+void ZppJournal::acknowledged(uint32_t addr) const {
+  std::array<uint8_t, record_size> record{};
+  uint32_2data(addr, begin(record));
+  record.back() = crc8({cbegin(record), record_size - 1uz});
+  _append(record);
+}
+
+/// Parse journal
+///
+/// \param  bytes                       Journal
+/// \retval ZppJournalState             Journal content
+/// \retval std::errc::invalid_argument Wrong magic or size
+/// \retval std::errc::bad_message      Header CRC error
+std::expected<ZppJournalState, std::errc>
+parse_zpp_journal(std::span<uint8_t const> bytes) {
+  if (size(bytes) < header_size ||
+      !std::ranges::equal(bytes.first<size(zpp_journal_magic)>(),
+                          zpp_journal_magic))
+    return std::unexpected{std::errc::invalid_argument};
+  if (crc8(bytes.first<header_size>()))
+    return std::unexpected{std::errc::bad_message};
+  ZppJournalState state{};
+  auto it{cbegin(bytes) + size(zpp_journal_magic)};
+  state.session.image_crc = data2uint32(it);
+  state.session.image_size = data2uint32(it += 4);
+  std::copy_n(it += 4, size(state.session.features),
+              begin(state.session.features));
+  std::copy_n(it += 4, size(state.session.developer_code),
+              begin(state.session.developer_code));
+  state.session.load_code_valid = *(it += 4);
+  for (auto records{bytes.subspan(header_size)};
+       size(records) >= record_size && !crc8(records.first<record_size>());
+       records = records.subspan(record_size))
+    state.acknowledged = data2uint32(cbegin(records));
+  return state;
+}
+
+/// Get address to resume an update at
+///
+/// \param  state         Journal content
+/// \param  session       Current session
+/// \retval uint32_t      Address to continue writing at without erasing
+/// \retval std::nullopt  Session differs, update has to start over
+std::optional<uint32_t> resume_address(ZppJournalState const& state,
+                                       ZppSession const& session) {
+  if (state.session != session) return std::nullopt;
+  return state.acknowledged.value_or(0u);
+}
+
+} // namespace zusi::tx
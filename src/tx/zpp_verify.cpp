@@ -0,0 +1,97 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// ZPP verification
+///
+/// \file   tx/zpp_verify.cpp
+/// \author Vincent Hamp
+/// \date   19/10/2026
+
+#include <algorithm>
+#include "zusi.hpp"
+
+namespace zusi::tx {
+
+namespace {
+
+/// Bisect range and append bad ranges
+///
+/// \param  base                        Transmit base
+/// \param  range                       Range to check
+/// \param  bytes                       Expected content of range
+/// \param  min_size                    Smallest range to bisect into
+/// \param  bad                         Bad ranges
+/// \param  known_bad                   Range is known to mismatch
+/// \retval true                        Range contains bad ranges
+/// \retval false                       Range matches
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+std::expected<bool, std::errc> bisect(Base& base,
+                                      ZppRange range,
+                                      std::span<uint8_t const> bytes,
+                                      size_t min_size,
+                                      std::vector<ZppRange>& bad,
+                                      bool known_bad = false) {
+  if (!known_bad) {
+    auto const match{base.verifyRange(range.addr, bytes)};
+    if (!match) return std::unexpected{match.error()};
+    else if (*match) return false;
+  }
+  if (range.size <= min_size) {
+    if (!empty(bad) && bad.back().addr + bad.back().size == range.addr)
+      bad.back().size += range.size;
+    else bad.push_back(range);
+    return true;
+  }
+  // Split at a multiple of min_size so that bad ranges stay aligned
+  auto const half{(range.size / 2uz + min_size - 1uz) / min_size * min_size};
+  auto const first{bisect(base,
+                          {.addr = range.addr, .size = half},
+                          bytes.first(half),
+                          min_size,
+                          bad)};
+  if (!first) return first;
+  // If the first half matches the second one can't
+  auto const second{bisect(base,
+                           {.addr = static_cast<uint32_t>(range.addr + half),
+                            .size = range.size - half},
+                           bytes.subspan(half),
+                           min_size,
+                           bad,
+                           !*first)};
+  if (!second) return second;
+  return true;
+}
+
+} // namespace
+
+/// Find ranges whose content differs from bytes
+///
+/// \param  base                        Transmit base
+/// \param  addr                        First address
+/// \param  bytes                       Expected content
+/// \param  min_size                    Smallest range to bisect into
+/// \retval std::vector<ZppRange>       Bad ranges (empty if all match)
+/// \retval std::errc::connection_reset No response
+/// \retval std::errc::protocol_error   NAK
+/// \retval std::errc::bad_message      CRC error
+std::expected<std::vector<ZppRange>, std::errc>
+find_bad_ranges(Base& base,
+                uint32_t addr,
+                std::span<uint8_t const> bytes,
+                size_t min_size) {
+  std::vector<ZppRange> bad;
+  if (empty(bytes)) return bad;
+  if (auto const result{bisect(base,
+                               {.addr = addr, .size = size(bytes)},
+                               bytes,
+                               std::max(min_size, 1uz),
+                               bad)};
+      !result)
+    return std::unexpected{result.error()};
+  return bad;
+}
+
+} // namespace zusi::tx
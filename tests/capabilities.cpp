@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <zusi/zusi.hpp>
+
+using zusi::Capabilities;
+using zusi::CapabilityBytes;
+using zusi::Mbps;
+
+namespace {
+
+constexpr Capabilities fast{.zpp_write_burst = true,
+                            .zpp_write_compressed = true,
+                            .zpp_crc32_query = true,
+                            .fast_response = true,
+                            .zpp_erase_range = true,
+                            .mbps = Mbps::_1_807,
+                            .fast_timing = true,
+                            .zpp_write_burst_blocks = 256uz,
+                            .page_size = 256uz};
+
+constexpr Capabilities slow{.zpp_write_burst = true,
+                            .zpp_crc32_query = true,
+                            .mbps = Mbps::_0_286,
+                            .zpp_write_burst_blocks = 16uz,
+                            .page_size = 4096uz};
+
+} // namespace
+
+// Encoding must round trip
+static_assert(zusi::data2capabilities(zusi::capabilities2data(fast)) == fast);
+static_assert(zusi::data2capabilities(zusi::capabilities2data(slow)) == slow);
+
+TEST(Capabilities, encoding) {
+  EXPECT_EQ(zusi::capabilities2data(fast),
+            (CapabilityBytes{0b1'1111u, 0b1111u, 0xFFu, 0b1111'1100u}));
+  EXPECT_EQ(zusi::capabilities2data(slow),
+            (CapabilityBytes{0b0'0101u, 0b0001u, 0b1111u, 0b1100'0000u}));
+  EXPECT_EQ(zusi::capabilities2data({}), CapabilityBytes{});
+}
+
+TEST(Capabilities, wired_and_yields_common_capabilities) {
+  auto const lhs{zusi::capabilities2data(fast)};
+  auto const rhs{zusi::capabilities2data(slow)};
+  CapabilityBytes bus;
+  for (auto i{0uz}; i < size(bus); ++i)
+    bus[i] = static_cast<uint8_t>(lhs[i] & rhs[i]);
+
+  auto const common{zusi::data2capabilities(bus)};
+  EXPECT_EQ(common, fast & slow);
+  EXPECT_TRUE(common.zpp_write_burst);
+  EXPECT_FALSE(common.zpp_write_compressed);
+  EXPECT_EQ(common.mbps, Mbps::_0_286);
+  EXPECT_FALSE(common.fast_timing);
+  EXPECT_EQ(common.zpp_write_burst_blocks, 16uz);
+  EXPECT_EQ(common.page_size, 4096uz);
+}
+
+TEST(Capabilities, from_features) {
+  auto const caps{
+    zusi::features2capabilities({0b1111'1011u, 0b1110'1010u, 0xFFu, 0xFFu})};
+  EXPECT_TRUE(caps.zpp_write_burst);
+  EXPECT_FALSE(caps.zpp_write_compressed);
+  EXPECT_TRUE(caps.zpp_crc32_query);
+  EXPECT_FALSE(caps.fast_response);
+  EXPECT_TRUE(caps.zpp_erase_range);
+  EXPECT_EQ(caps.mbps, Mbps::_1_807);
+  EXPECT_FALSE(caps.fast_timing);
+  EXPECT_EQ(caps.zpp_write_burst_blocks, zusi::zpp_write_burst_max_blocks);
+  EXPECT_EQ(caps.page_size, 0uz);
+}
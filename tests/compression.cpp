@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <zusi/zusi.hpp>
+
+namespace {
+
+std::vector<uint8_t> round_trip(std::vector<uint8_t> const& bytes) {
+  std::array<uint8_t, 512uz> compressed{};
+  auto const count{zusi::compress(bytes, compressed)};
+  EXPECT_TRUE(count);
+  std::span<uint8_t const> const src{data(compressed), count};
+  EXPECT_EQ(zusi::decompressed_size(src), size(bytes));
+  std::array<uint8_t, zusi::compression_window> block{};
+  auto const length{zusi::decompress(src, block)};
+  EXPECT_TRUE(length);
+  return {cbegin(block), cbegin(block) + length.value_or(0uz)};
+}
+
+} // namespace
+
+TEST(compression, run) {
+  std::vector<uint8_t> bytes(256uz, 0xFFu);
+  std::array<uint8_t, 255uz> compressed{};
+  auto const count{zusi::compress(bytes, compressed)};
+  // 4 runs of 66 bytes at most, 2 bytes each
+  EXPECT_EQ(count, 8uz);
+  EXPECT_EQ(round_trip(bytes), bytes);
+}
+
+TEST(compression, copy) {
+  std::vector<uint8_t> bytes(256uz);
+  for (auto i{0uz}; i < size(bytes); ++i)
+    bytes[i] = static_cast<uint8_t>(i % 16uz * 7uz);
+  std::array<uint8_t, 255uz> compressed{};
+  EXPECT_LT(zusi::compress(bytes, compressed), 32uz);
+  EXPECT_EQ(round_trip(bytes), bytes);
+}
+
+TEST(compression, random) {
+  std::mt19937 gen{42u};
+  std::uniform_int_distribution<uint32_t> dist{0u, 255u};
+  for (auto i{0uz}; i < 100uz; ++i) {
+    std::vector<uint8_t> bytes(1uz + i % 256uz);
+    std::ranges::generate(bytes, [&] {
+      // Few distinct values to get a mix of all tokens
+      return static_cast<uint8_t>(dist(gen) % (i % 2uz ? 4u : 256u));
+    });
+    EXPECT_EQ(round_trip(bytes), bytes);
+  }
+}
+
+TEST(compression, incompressible_does_not_fit) {
+  std::vector<uint8_t> bytes(256uz);
+  std::iota(begin(bytes), end(bytes), 0u);
+  std::array<uint8_t, 255uz> compressed{};
+  EXPECT_EQ(zusi::compress(bytes, compressed), 0uz);
+}
+
+TEST(compression, malformed) {
+  // Literals past end
+  EXPECT_FALSE(zusi::decompressed_size(std::array<uint8_t, 2uz>{0x05u, 0u}));
+  // Copy before start of block
+  EXPECT_FALSE(
+    zusi::decompressed_size(std::array<uint8_t, 4uz>{0x00u, 1u, 0xC0u, 1u}));
+  // Larger than window
+  std::array<uint8_t, 10uz> const runs{
+    0xBFu, 0u, 0xBFu, 0u, 0xBFu, 0u, 0xBFu, 0u, 0x80u, 0u};
+  EXPECT_FALSE(zusi::decompressed_size(runs));
+  std::array<uint8_t, zusi::compression_window> block{};
+  EXPECT_FALSE(zusi::decompress(runs, block));
+}
@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+#include <zusi/zusi.hpp>
+
+TEST(crc32, check) {
+  std::string const str{"123456789"};
+  std::vector<uint8_t> v;
+  std::ranges::copy(str, std::back_inserter(v));
+  EXPECT_EQ(zusi::crc32(v), 0xCBF4'3926u);
+}
+
+TEST(crc32, continued) {
+  std::string const str{"Hello World!"};
+  std::vector<uint8_t> v;
+  std::ranges::copy(str, std::back_inserter(v));
+  std::span<uint8_t const> const bytes{v};
+  EXPECT_EQ(zusi::crc32(bytes.subspan(5uz), zusi::crc32(bytes.first(5uz))),
+            zusi::crc32(bytes));
+}
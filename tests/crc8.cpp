@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <numeric>
 #include <zusi/zusi.hpp>
 
 TEST(crc8, data) {
@@ -23,3 +24,12 @@ TEST(crc8, string) {
   std::ranges::copy(str, std::back_inserter(v));
   EXPECT_EQ(zusi::crc8(v), 0x9Eu);
 }
+
+TEST(crc8, running) {
+  std::array<uint8_t, 300uz> data;
+  std::iota(begin(data), end(data), 0u);
+  std::span const bytes{data};
+  for (auto const split : {0uz, 1uz, 6uz, 262uz, 300uz})
+    EXPECT_EQ(zusi::crc8(bytes.subspan(split), zusi::crc8(bytes.first(split))),
+              zusi::crc8(bytes));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <zusi/zusi.hpp>
+
+namespace {
+
+// Header, data and CRC8 of a whole ZPP-Write-FEC packet
+std::vector<uint8_t> make_bytes(size_t size = 262uz) {
+  std::vector<uint8_t> bytes(size);
+  std::iota(begin(bytes), end(bytes), 0x35u);
+  return bytes;
+}
+
+} // namespace
+
+// Parity only depends on the data
+static_assert(zusi::fec_encode({}) == zusi::FecParity{});
+
+TEST(fec, no_error) {
+  auto bytes{make_bytes()};
+  auto const copy{bytes};
+  auto const parity{zusi::fec_encode(bytes)};
+
+  EXPECT_EQ(zusi::fec_decode(bytes, parity), 0uz);
+  EXPECT_EQ(bytes, copy);
+}
+
+TEST(fec, every_single_bit_error_gets_corrected) {
+  auto const bytes{make_bytes()};
+  auto const parity{zusi::fec_encode(bytes)};
+  for (auto i{0uz}; i < size(bytes); ++i)
+    for (auto b{0uz}; b < CHAR_BIT; ++b) {
+      auto corrupted{bytes};
+      corrupted[i] ^= static_cast<uint8_t>(1u << b);
+      ASSERT_EQ(zusi::fec_decode(corrupted, parity), 1uz) << i << ' ' << b;
+      ASSERT_EQ(corrupted, bytes);
+    }
+}
+
+TEST(fec, parity_errors_leave_bytes_alone) {
+  auto const bytes{make_bytes()};
+  auto const parity{zusi::fec_encode(bytes)};
+  for (auto k{0uz}; k < zusi::fec_parity_size; ++k) {
+    auto copy{bytes};
+    auto corrupted{parity};
+    corrupted[k] ^= 0x81u;
+    EXPECT_EQ(zusi::fec_decode(copy, corrupted), 0uz);
+    EXPECT_EQ(copy, bytes);
+  }
+}
+
+TEST(fec, whole_byte_gets_corrected) {
+  auto const bytes{make_bytes()};
+  auto const parity{zusi::fec_encode(bytes)};
+  auto corrupted{bytes};
+  corrupted[100uz] = static_cast<uint8_t>(~corrupted[100uz]);
+
+  EXPECT_EQ(zusi::fec_decode(corrupted, parity), 8uz);
+  EXPECT_EQ(corrupted, bytes);
+}
+
+TEST(fec, errors_in_different_lanes_get_corrected) {
+  auto const bytes{make_bytes()};
+  auto const parity{zusi::fec_encode(bytes)};
+  auto corrupted{bytes};
+  corrupted[0uz] ^= 0x01u;
+  corrupted[261uz] ^= 0x80u;
+
+  EXPECT_EQ(zusi::fec_decode(corrupted, parity), 2uz);
+  EXPECT_EQ(corrupted, bytes);
+}
+
+TEST(fec, two_errors_in_same_lane_are_detected) {
+  auto const bytes{make_bytes()};
+  auto const parity{zusi::fec_encode(bytes)};
+  auto corrupted{bytes};
+  corrupted[3uz] ^= 0x10u;
+  corrupted[7uz] ^= 0x10u;
+  corrupted[50uz] ^= 0x01u;
+  auto const copy{corrupted};
+
+  EXPECT_FALSE(zusi::fec_decode(corrupted, parity));
+  EXPECT_EQ(corrupted, copy);
+}
+
+TEST(fec, largest_range) {
+  auto const bytes{make_bytes(zusi::fec_max_size)};
+  auto const parity{zusi::fec_encode(bytes)};
+  auto corrupted{bytes};
+  corrupted.back() ^= 0x04u;
+
+  EXPECT_EQ(zusi::fec_decode(corrupted, parity), 1uz);
+  EXPECT_EQ(corrupted, bytes);
+}
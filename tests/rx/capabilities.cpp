@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <vector>
+#include "rx_test.hpp"
+
+#if ZUSI_RX_CAPABILITIES
+using namespace std::chrono_literals;
+
+namespace {
+
+// Receiver which advertises more than its features
+class RxCapabilitiesMock : public RxMock {
+public:
+  MOCK_METHOD(zusi::Capabilities, capabilities, (), (const, override));
+};
+
+// Bytes transmitted bit by bit after ACK valid, ACK and busy
+std::vector<uint8_t> response(RxMock& mock, uint8_t page) {
+  auto const packet{zusi::make_capabilities_packet(page)};
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(mock, waitClock(_)).WillRepeatedly(Return(true));
+  std::vector<bool> bits;
+  EXPECT_CALL(mock, writeData(_)).WillRepeatedly([&](bool state) {
+    bits.push_back(state);
+  });
+
+  auto const then{std::chrono::system_clock::now() + 100ms};
+  while (std::chrono::system_clock::now() < then) mock.receive();
+
+  std::vector<uint8_t> bytes((size(bits) - 4uz) / CHAR_BIT);
+  for (auto i{0uz}; i < size(bytes) * CHAR_BIT; ++i)
+    bytes[i / CHAR_BIT] |= static_cast<uint8_t>(bits[4uz + i] << i % CHAR_BIT);
+  return bytes;
+}
+
+} // namespace
+
+TEST(RxCapabilities, sent_twice) {
+  NiceMock<RxCapabilitiesMock> mock;
+  zusi::Capabilities const caps{.zpp_write_burst = true,
+                                .mbps = zusi::Mbps::_1_364,
+                                .fast_timing = true,
+                                .zpp_write_burst_blocks = 64uz,
+                                .page_size = 512uz};
+  EXPECT_CALL(mock, capabilities()).WillOnce(Return(caps));
+
+  auto const bytes{response(mock, 0u)};
+  auto const expected{zusi::capabilities2data(caps)};
+  ASSERT_EQ(size(bytes), 2uz * size(expected));
+  EXPECT_TRUE(std::equal(cbegin(expected), cend(expected), cbegin(bytes)));
+  EXPECT_TRUE(std::equal(cbegin(expected), cend(expected), cbegin(bytes) + 4));
+}
+
+TEST(RxCapabilities, derived_from_features) {
+  NiceMock<RxMock> mock;
+  zusi::Features const features{0b1111'1101u, 0b1111'1110u, 0xFFu, 0xFFu};
+  EXPECT_CALL(mock, features()).WillOnce(Return(features));
+
+  auto const bytes{response(mock, 0u)};
+  auto caps{zusi::features2capabilities(features)};
+  // Several CVs per frame need a buffer sized for ZPP-Write
+  caps.cv_multiple = zusi::rx::packet_size >= zusi::data_pos + 256uz + 1uz;
+  auto const expected{zusi::capabilities2data(caps)};
+  ASSERT_EQ(size(bytes), 8uz);
+  EXPECT_TRUE(std::equal(cbegin(expected), cend(expected), cbegin(bytes)));
+}
+
+TEST(RxCapabilities, unknown_page) {
+  NiceMock<RxCapabilitiesMock> mock;
+  EXPECT_CALL(mock, capabilities()).Times(0);
+
+  auto const bytes{response(mock, 1u)};
+  EXPECT_EQ(bytes, std::vector<uint8_t>(8uz));
+}
+#endif
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <zusi/zusi.hpp>
+
+using zusi::Command;
+using zusi::rx::is_enabled_command;
+using zusi::rx::max_packet_size;
+
+namespace {
+
+constexpr uint32_t mask(std::initializer_list<Command> cmds) {
+  uint32_t retval{};
+  for (auto const cmd : cmds) retval |= 1u << std::to_underlying(cmd);
+  return retval;
+}
+
+} // namespace
+
+TEST(RxCommands, features_and_exit_always_enabled) {
+  EXPECT_TRUE(is_enabled_command(Command::Features, 0u));
+  EXPECT_TRUE(is_enabled_command(Command::Exit, 0u));
+  EXPECT_FALSE(is_enabled_command(Command::CvRead, 0u));
+  EXPECT_FALSE(is_enabled_command(Command::ZppWrite, 0u));
+}
+
+TEST(RxCommands, mask_selects_commands) {
+  auto const cmds{mask({Command::CvRead, Command::ZppCopy})};
+  EXPECT_TRUE(is_enabled_command(Command::CvRead, cmds));
+  EXPECT_TRUE(is_enabled_command(Command::ZppCopy, cmds));
+  EXPECT_FALSE(is_enabled_command(Command::CvWrite, cmds));
+  EXPECT_FALSE(is_enabled_command(Command::ZppErase, cmds));
+}
+
+TEST(RxCommands, enabled_commands_match_mask) {
+  EXPECT_EQ(zusi::rx::enabled_commands, ZUSI_RX_COMMANDS);
+  EXPECT_EQ(is_enabled_command(Command::CvRead), ZUSI_RX_CV_READ);
+  EXPECT_EQ(is_enabled_command(Command::ZppCopy), ZUSI_RX_ZPP_COPY);
+  EXPECT_EQ(zusi::rx::packet_size, max_packet_size(ZUSI_RX_COMMANDS));
+}
+
+TEST(RxCommands, max_packet_size_cv_only) {
+  EXPECT_EQ(max_packet_size(mask({Command::CvRead, Command::CvWrite})), 8uz);
+  EXPECT_EQ(max_packet_size(mask({Command::CvRead})), 7uz);
+  // Exit
+  EXPECT_EQ(max_packet_size(0u), 5uz);
+}
+
+TEST(RxCommands, max_packet_size_zpp) {
+  EXPECT_EQ(max_packet_size(mask({Command::ZppCopy})), 14uz);
+  EXPECT_EQ(max_packet_size(mask({Command::ZppWrite})),
+            ZUSI_RX_CHUNK_SIZE ? zusi::data_pos + ZUSI_RX_CHUNK_SIZE + 1uz
+                               : ZUSI_MAX_PACKET_SIZE);
+  EXPECT_EQ(max_packet_size(0xFFFFu),
+            ZUSI_RX_CHUNK_SIZE ? zusi::data_pos + ZUSI_RX_CHUNK_SIZE + 1uz
+                               : ZUSI_MAX_PACKET_SIZE);
+}
+
+TEST(RxCommands, chunk_mode_disables_whole_block_commands) {
+  EXPECT_NE(is_enabled_command(Command::ZppWriteCompressed, 0xFFFFu),
+            static_cast<bool>(ZUSI_RX_CHUNK_SIZE));
+  EXPECT_NE(is_enabled_command(Command::ZppWriteFec, 0xFFFFu),
+            static_cast<bool>(ZUSI_RX_CHUNK_SIZE));
+}
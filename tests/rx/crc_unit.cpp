@@ -0,0 +1,119 @@
+#include <numeric>
+#include "rx_test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Bitwise model of a CRC unit (polynomial 0x31 reflected, no final XOR)
+uint8_t crc_unit(std::span<uint8_t const> bytes, uint8_t crc) {
+  for (auto const byte : bytes) {
+    crc ^= byte;
+    for (auto i{0uz}; i < CHAR_BIT; ++i)
+      crc = static_cast<uint8_t>(crc & 1u ? crc >> 1u ^ 0x8Cu : crc >> 1u);
+  }
+  return crc;
+}
+
+// Receiver which accumulates CRC8 in "hardware"
+class RxCrcUnitMock : public RxMock {
+public:
+  RxCrcUnitMock() {
+    ON_CALL(*this, accumulateCrc8(_, _)).WillByDefault(crc_unit);
+  }
+
+  MOCK_METHOD(uint8_t,
+              accumulateCrc8,
+              (std::span<uint8_t const>, uint8_t),
+              (const, override));
+};
+
+// Feed packet and return everything written to the data line
+std::vector<bool> run(RxMock& mock, zusi::Packet const& packet) {
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(mock, waitClock(_)).WillRepeatedly(Return(true));
+#if ZUSI_RX_ZPP_ADDRESS
+  EXPECT_CALL(mock, addressValid(_)).WillRepeatedly(Return(true));
+#endif
+#if ZUSI_RX_CV_READ
+  EXPECT_CALL(mock, readCv(_)).WillRepeatedly(Return(0x42u));
+#endif
+  std::vector<bool> bits;
+  EXPECT_CALL(mock, writeData(_)).WillRepeatedly([&](bool state) {
+    bits.push_back(state);
+  });
+
+  auto const then{std::chrono::system_clock::now() + 100ms};
+  while (std::chrono::system_clock::now() < then) mock.receive();
+  return bits;
+}
+
+#if ZUSI_RX_COMMAND(0x05u)
+zusi::Packet make_zpp_write_packet() {
+  std::array<uint8_t, 256uz> bytes;
+  std::iota(begin(bytes), end(bytes), 0u);
+  return zusi::make_zpp_write_packet(255u, 0x0001'0000u, bytes);
+}
+#endif
+
+} // namespace
+
+TEST(RxCrcUnit, model_matches_software) {
+  std::array<uint8_t, 256uz> bytes;
+  std::iota(begin(bytes), end(bytes), 0x5Au);
+  for (auto const crc : {0x00u, 0x31u, 0xFFu})
+    EXPECT_EQ(crc_unit(bytes, static_cast<uint8_t>(crc)),
+              zusi::crc8(bytes, static_cast<uint8_t>(crc)));
+}
+
+#if ZUSI_RX_COMMAND(0x05u)
+TEST(RxCrcUnit, zpp_write_in_blocks) {
+  auto const packet{make_zpp_write_packet()};
+  NiceMock<RxMock> software;
+  NiceMock<RxCrcUnitMock> hardware;
+  // Command, size, address and data each arrive as a block
+  auto calls{0uz};
+  EXPECT_CALL(hardware, accumulateCrc8(_, _))
+    .WillRepeatedly([&](std::span<uint8_t const> bytes, uint8_t crc) {
+      ++calls;
+      return crc_unit(bytes, crc);
+    });
+
+  auto const bits{run(software, packet)};
+  EXPECT_EQ(run(hardware, packet), bits);
+  ASSERT_GE(size(bits), 2uz);
+  EXPECT_TRUE(bits[1uz]); // ACK
+  EXPECT_LT(calls, size(packet) / 4uz);
+}
+
+TEST(RxCrcUnit, zpp_write_crc_error) {
+  auto packet{make_zpp_write_packet()};
+  packet.back() = static_cast<uint8_t>(~packet.back());
+  NiceMock<RxMock> software;
+  NiceMock<RxCrcUnitMock> hardware;
+
+  auto const bits{run(software, packet)};
+  EXPECT_EQ(run(hardware, packet), bits);
+}
+
+#endif
+
+#if ZUSI_RX_CV_READ
+TEST(RxCrcUnit, cv_read_response) {
+  auto const packet{zusi::make_cv_read_packet(0u, 8u)};
+  NiceMock<RxMock> software;
+  NiceMock<RxCrcUnitMock> hardware;
+  // Request and response
+  EXPECT_CALL(hardware, accumulateCrc8(_, _)).Times(AtLeast(2));
+
+  auto const bits{run(software, packet)};
+  EXPECT_EQ(run(hardware, packet), bits);
+  EXPECT_EQ(size(bits), 4uz + 2uz * CHAR_BIT);
+}
+#endif
@@ -1,5 +1,6 @@
 #include "rx_test.hpp"
 
+#if ZUSI_RX_CV_READ
 using namespace std::chrono_literals;
 
 TEST_F(RxTest, cv_read) {
@@ -29,3 +30,29 @@ TEST_F(RxTest, cv_read) {
 
   RunFor(100ms);
 }
+
+TEST_F(RxTest, cv_read_multiple) {
+  auto const packet{zusi::make_cv_read_packet(2u, 8u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, readCv(8u)).WillOnce(Return(0x01u));
+  EXPECT_CALL(_mock, readCv(9u)).WillOnce(Return(0x02u));
+  EXPECT_CALL(_mock, readCv(10u)).WillOnce(Return(0x03u));
+  EXPECT_CALL(_mock, writeData(_))
+    .Times(Exactly(1 +            // ack_valid
+                   1 +            // ack
+                   1 +            // busy
+                   1 +            // busy
+                   3 * CHAR_BIT + // CVs
+                   CHAR_BIT));    // CRC
+
+  RunFor(100ms);
+}
+#endif
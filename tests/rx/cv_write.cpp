@@ -0,0 +1,90 @@
+#include <numeric>
+#include "rx_test.hpp"
+
+#if ZUSI_RX_CV_WRITE
+using namespace std::chrono_literals;
+
+TEST_F(RxTest, cv_write) {
+  std::array<uint8_t, 1uz> const values{0x2Au};
+  auto const packet{zusi::make_cv_write_packet(0u, 8u, values)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, writeCv(8u, 0x2Au)).Times(1);
+
+  RunFor(100ms);
+}
+
+TEST_F(RxTest, cv_write_multiple) {
+  std::array<uint8_t, 3uz> const values{0x01u, 0x02u, 0x03u};
+  auto const packet{zusi::make_cv_write_packet(2u, 8u, values)};
+  // Receivers with only CV commands enabled buffer a single CV
+  auto const fits{zusi::rx::packet_size >= size(packet)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  Sequence writes;
+  EXPECT_CALL(_mock, writeCv(8u, 0x01u)).Times(fits).InSequence(writes);
+  EXPECT_CALL(_mock, writeCv(9u, 0x02u)).Times(fits).InSequence(writes);
+  EXPECT_CALL(_mock, writeCv(10u, 0x03u)).Times(fits).InSequence(writes);
+
+  RunFor(100ms);
+}
+
+TEST_F(RxTest, cv_write_multiple_crc_error) {
+  std::array<uint8_t, 3uz> const values{0x01u, 0x02u, 0x03u};
+  auto packet{zusi::make_cv_write_packet(2u, 8u, values)};
+  packet[zusi::data_pos + 1uz] ^= 0xFFu;
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, writeCv(_, _)).Times(0);
+
+  RunFor(100ms);
+}
+
+// Frames with more CVs than the buffer holds get NAKed without losing sync
+TEST_F(RxTest, cv_write_all) {
+  std::array<uint8_t, 256uz> values;
+  std::iota(begin(values), end(values), 0u);
+  auto const all{zusi::make_cv_write_packet(255u, 0u, values)};
+  std::array<uint8_t, 1uz> const value{0x2Au};
+  auto const single{zusi::make_cv_write_packet(0u, 1000u, value)};
+  auto const fits{zusi::rx::packet_size >= size(all)};
+
+  Sequence seq;
+  for (auto const& packet : {all, single}) {
+    for (auto const byte : packet)
+      EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+    EXPECT_CALL(_mock, receiveByte())
+      .InSequence(seq)
+      .WillOnce(Return(zusi::resync_byte));
+  }
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, writeCv(Lt(256u), _)).Times(fits ? 256 : 0);
+  EXPECT_CALL(_mock, writeCv(1000u, 0x2Au)).Times(1);
+
+  RunFor(100ms);
+}
+#endif
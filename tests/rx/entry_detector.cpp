@@ -0,0 +1,60 @@
+#include "rx_test.hpp"
+
+using zusi::rx::Entry;
+using zusi::rx::EntryDetector;
+
+namespace {
+
+// Feed periods of a sequence, return what got detected at every edge
+std::vector<Entry> feed(EntryDetector& detector,
+                        size_t periods,
+                        uint32_t period_us,
+                        uint32_t time_us = 0u) {
+  std::vector<Entry> entries;
+  for (auto i{0uz}; i < periods; ++i, time_us += period_us)
+    entries.push_back(detector.fallingEdge(i % 2uz, time_us));
+  return entries;
+}
+
+} // namespace
+
+TEST(EntryDetector, fast) {
+  EntryDetector detector;
+  auto const entries{
+    feed(detector, zusi::fast_entry_periods, zusi::fast_entry_period_us)};
+  EXPECT_EQ(std::ranges::count(entries, Entry::Fast), 1);
+  EXPECT_EQ(entries[EntryDetector::fast_periods], Entry::Fast);
+}
+
+TEST(EntryDetector, regular) {
+  EntryDetector detector;
+  auto const entries{
+    feed(detector, zusi::entry_periods, zusi::entry_period_us)};
+  EXPECT_EQ(std::ranges::count(entries, Entry::Regular), 1);
+  EXPECT_EQ(std::ranges::count(entries, Entry::Fast), 0);
+}
+
+TEST(EntryDetector, late_start) {
+  EntryDetector detector;
+  // Device only starts listening halfway through
+  auto const entries{feed(detector,
+                          zusi::fast_entry_periods / 2uz + 1uz,
+                          zusi::fast_entry_period_us,
+                          12'345u)};
+  EXPECT_EQ(entries.back(), Entry::Fast);
+}
+
+TEST(EntryDetector, data_must_alternate) {
+  EntryDetector detector;
+  for (auto i{0uz}; i < zusi::fast_entry_periods; ++i)
+    EXPECT_EQ(detector.fallingEdge(
+                true, static_cast<uint32_t>(i) * zusi::fast_entry_period_us),
+              Entry::None);
+}
+
+TEST(EntryDetector, period_out_of_range) {
+  EntryDetector detector;
+  auto const entries{feed(detector, zusi::fast_entry_periods, 100u)};
+  EXPECT_TRUE(std::ranges::all_of(
+    entries, [](Entry entry) { return entry == Entry::None; }));
+}
@@ -0,0 +1,114 @@
+#include "rx_test.hpp"
+
+using namespace std::chrono_literals;
+using zusi::rx::Cause;
+using zusi::rx::EventLog;
+
+TEST(EventLog, record) {
+  EventLog<4uz> log;
+  log.record(10u, 0u, 1u);
+  log.record(25u, 1u, 6u, Cause::Timeout);
+  log.record(30u, 6u, 0u);
+
+  EXPECT_EQ(log.count(), 3u);
+  EXPECT_EQ(log[1uz].time, 25u);
+  EXPECT_EQ(log[1uz].cause, Cause::Timeout);
+  EXPECT_EQ(log.entries(6u), 1u);
+  EXPECT_EQ(log.ticks(0u), 10u);
+  EXPECT_EQ(log.ticks(1u), 15u);
+  EXPECT_EQ(log.ticks(6u), 5u);
+  EXPECT_EQ(log.errors(Cause::Timeout), 1u);
+}
+
+TEST(EventLog, wrap) {
+  EventLog<4uz> log;
+  for (auto i{0u}; i < 6u; ++i) log.record(i, 0u, 1u);
+  EXPECT_EQ(log.count(), 6u);
+  EXPECT_EQ(log[0uz].time, 2u);
+  EXPECT_EQ(log[3uz].time, 5u);
+}
+
+TEST(EventLog, cv) {
+  EventLog<2uz> log;
+  log.record(0x1234'5678u, 2u, 6u, Cause::NoResync);
+
+  // Number of events
+  EXPECT_EQ(log.cv(3u), 1u);
+  // Transitions into Error
+  EXPECT_EQ(log.cv(4u + 6u * 4u + 3u), 1u);
+  // Ticks spent in ReceiveResync
+  auto const ticks{4u + zusi::rx::event_log_states * 4u + 2u * 4u};
+  EXPECT_EQ(log.cv(ticks), 0x12u);
+  EXPECT_EQ(log.cv(ticks + 3u), 0x78u);
+  // Errors by cause
+  auto const errors{4u + zusi::rx::event_log_states * 8u};
+  EXPECT_EQ(log.cv(errors + std::to_underlying(Cause::NoResync) * 4u + 3u),
+            1u);
+  // First event
+  auto const events{errors + zusi::rx::event_log_causes * 4u};
+  EXPECT_EQ(log.cv(events), 0x12u);
+  EXPECT_EQ(log.cv(events + 4u), 2u);
+  EXPECT_EQ(log.cv(events + 5u), 6u);
+  EXPECT_EQ(log.cv(events + 6u), std::to_underlying(Cause::NoResync));
+  EXPECT_EQ(events + 2u * 8u, log.cv_count);
+  EXPECT_EQ(log.cv(log.cv_count), 0u);
+}
+
+#if ZUSI_RX_EVENT_LOG_SIZE && ZUSI_RX_CV_READ
+TEST_F(RxTest, event_log_crc_error) {
+  zusi::Packet packet{
+    std::to_underlying(zusi::Command::CvRead), 0u, 0u, 0u, 0u, 0u};
+  uint32_t time{};
+  EXPECT_CALL(_mock, timestamp()).WillRepeatedly([&] { return time += 10u; });
+  EXPECT_CALL(_mock, receiveByte())
+    .WillOnce(Return(packet[0uz]))
+    .WillOnce(Return(packet[1uz]))
+    .WillOnce(Return(packet[2uz]))
+    .WillOnce(Return(packet[3uz]))
+    .WillOnce(Return(packet[4uz]))
+    .WillOnce(Return(packet[5uz]))
+    .WillOnce(Return(static_cast<uint8_t>(~zusi::crc8(packet))))
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+
+  RunFor(100ms);
+
+  // ReceiveCommand, ReceiveData, ReceiveResync, TransmitAck, Error
+  auto const& log{_mock.eventLog()};
+  ASSERT_GE(log.count(), 5u);
+  EXPECT_EQ(log[3uz].to, 6u);
+  EXPECT_EQ(log[3uz].cause, Cause::CrcError);
+  EXPECT_EQ(log.errors(Cause::CrcError), 1u);
+  // Idle timeouts afterwards are not recorded
+  EXPECT_EQ(log.count(), 5u);
+}
+
+TEST_F(RxTest, event_log_cv_read) {
+  auto const packet{zusi::make_cv_read_packet(0u, zusi::rx::event_log_cv + 3u)};
+  EXPECT_CALL(_mock, timestamp()).WillRepeatedly(Return(0u));
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, readCv(_)).Times(0);
+  std::vector<bool> bits;
+  EXPECT_CALL(_mock, writeData(_)).WillRepeatedly([&](bool state) {
+    bits.push_back(state);
+  });
+
+  RunFor(100ms);
+
+  // ACK valid, ACK, busy, busy, CV and CRC8
+  ASSERT_EQ(size(bits), 4uz + 2uz * CHAR_BIT);
+  uint8_t value{};
+  for (auto i{0uz}; i < CHAR_BIT; ++i)
+    value |= static_cast<uint8_t>(bits[4uz + i] << i);
+  // Four transitions recorded before the CV gets read
+  EXPECT_EQ(value, 4u);
+}
+#endif
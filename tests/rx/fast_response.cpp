@@ -0,0 +1,46 @@
+#include "rx_test.hpp"
+
+#if ZUSI_RX_CV_READ
+using namespace std::chrono_literals;
+
+namespace {
+
+// Receiver which answers the response phase with SPI
+class RxSpiMock : public RxMock {
+public:
+  MOCK_METHOD(bool,
+              transmitBytes,
+              (std::span<uint8_t const>),
+              (const, override));
+};
+
+} // namespace
+
+TEST(RxFastResponse, cv_read) {
+  NiceMock<RxSpiMock> mock;
+  zusi::Packet packet{
+    std::to_underlying(zusi::Command::CvRead), 0u, 0u, 0u, 0u, 0u};
+  EXPECT_CALL(mock, receiveByte())
+    .WillOnce(Return(packet[0uz]))
+    .WillOnce(Return(packet[1uz]))
+    .WillOnce(Return(packet[2uz]))
+    .WillOnce(Return(packet[3uz]))
+    .WillOnce(Return(packet[4uz]))
+    .WillOnce(Return(packet[5uz]))
+    .WillOnce(Return(zusi::crc8(packet)))
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(mock, readCv(0u)).WillOnce(Return(42u));
+  EXPECT_CALL(mock, transmitBytes(ElementsAre(42u, zusi::crc8(42u))))
+    .WillOnce(Return(true));
+  EXPECT_CALL(mock, writeData(_))
+    .Times(Exactly(1 + // ack_valid
+                   1 + // ack
+                   1 + // busy
+                   1)); // busy
+
+  auto const then{std::chrono::system_clock::now() + 100ms};
+  while (std::chrono::system_clock::now() < then) mock.receive();
+}
+#endif
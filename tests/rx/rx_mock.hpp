@@ -5,17 +5,45 @@
 
 class RxMock : public zusi::rx::Base {
 public:
+#if ZUSI_RX_CV_READ
   MOCK_METHOD(uint8_t, readCv, (uint32_t), (const, override));
+#endif
+#if ZUSI_RX_CV_WRITE
   MOCK_METHOD(void, writeCv, (uint32_t, uint8_t), (override));
+#endif
+#if ZUSI_RX_ZPP_ERASE
   MOCK_METHOD(void, eraseZpp, (), (override));
+#endif
+#if ZUSI_RX_ZPP_ERASE_RANGE
+  MOCK_METHOD(void, eraseZppRange, (uint32_t, uint32_t), (override));
+#endif
+#if ZUSI_RX_ZPP_COPY
+  MOCK_METHOD(void, copyZpp, (uint32_t, uint32_t, uint32_t), (override));
+#endif
+#if ZUSI_RX_ZPP_CRC32_QUERY
+  MOCK_METHOD(uint32_t, crc32Zpp, (uint32_t, uint32_t), (const, override));
+#endif
+#if ZUSI_RX_ZPP_WRITE && ZUSI_RX_CHUNK_SIZE
+  MOCK_METHOD(void, stageZpp, (uint32_t, std::span<uint8_t const>), (override));
+  MOCK_METHOD(void, commitZpp, (), (override));
+  MOCK_METHOD(void, discardZpp, (), (override));
+#elif ZUSI_RX_ZPP_WRITE
   MOCK_METHOD(void, writeZpp, (uint32_t, std::span<uint8_t const>), (override));
+#endif
   MOCK_METHOD(zusi::Features, features, (), (const, override));
   MOCK_METHOD(void, exit, (uint8_t), (override));
+#if ZUSI_RX_ZPP_LC_DC_QUERY
   MOCK_METHOD(bool,
               loadCodeValid,
               ((std::span<uint8_t const, 4uz>)),
               (const, override));
+#endif
+#if ZUSI_RX_ZPP_ADDRESS
   MOCK_METHOD(bool, addressValid, (uint32_t), (const, override));
+#endif
+#if ZUSI_RX_EVENT_LOG_SIZE
+  MOCK_METHOD(uint32_t, timestamp, (), (const, override));
+#endif
   MOCK_METHOD(std::optional<uint8_t>, receiveByte, (), (const, override));
   MOCK_METHOD(bool, waitClock, (bool), (const, override));
   MOCK_METHOD(void, writeData, (bool), (const, override));
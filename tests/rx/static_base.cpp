@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <deque>
+#include <optional>
+#include <vector>
+#include <zusi/zusi.hpp>
+
+namespace {
+
+// Receiver without any virtual call, fed from a byte queue
+class StaticRxFake : public zusi::rx::StaticBase<StaticRxFake> {
+  friend zusi::rx::StaticBase<StaticRxFake>;
+
+public:
+  mutable std::deque<uint8_t> _rx{};
+  std::vector<std::pair<uint32_t, uint8_t>> _writes{};
+  std::vector<std::array<uint32_t, 3uz>> _copies{};
+  mutable std::vector<bool> _tx{};
+
+private:
+  uint8_t readCv(uint32_t addr) const { return static_cast<uint8_t>(addr); }
+  void writeCv(uint32_t addr, uint8_t byte) {
+    _writes.emplace_back(addr, byte);
+  }
+  void eraseZpp() {}
+#if ZUSI_RX_CHUNK_SIZE
+  void stageZpp(uint32_t, std::span<uint8_t const>) {}
+  void commitZpp() {}
+  void discardZpp() {}
+#else
+  void writeZpp(uint32_t, std::span<uint8_t const>) {}
+#endif
+  void copyZpp(uint32_t src, uint32_t dst, uint32_t size) {
+    _copies.push_back({src, dst, size});
+  }
+  uint32_t crc32Zpp(uint32_t addr, uint32_t size) const { return addr ^ size; }
+  zusi::Features features() const { return {}; }
+  void exit(uint8_t) {}
+  bool loadCodeValid(std::span<uint8_t const, 4uz>) const { return true; }
+  bool addressValid(uint32_t) const { return true; }
+#if ZUSI_RX_EVENT_LOG_SIZE
+  uint32_t timestamp() const { return 0u; }
+#endif
+
+  std::optional<uint8_t> receiveByte() const {
+    if (empty(_rx)) return std::nullopt;
+    auto const byte{_rx.front()};
+    _rx.pop_front();
+    return byte;
+  }
+
+  bool waitClock(bool) const { return true; }
+  void writeData(bool state) const { _tx.push_back(state); }
+  void spiSlave() const {}
+  void gpioOutput() const {}
+};
+
+} // namespace
+
+#if ZUSI_RX_CV_WRITE
+TEST(RxStaticBase, cv_write) {
+  StaticRxFake fake;
+  std::array<uint8_t, 1uz> const value{3u};
+  auto const packet{zusi::make_cv_write_packet(0u, 8u, value)};
+  fake._rx.assign(cbegin(packet), cend(packet));
+  fake._rx.push_back(zusi::resync_byte);
+
+  for (auto i{0uz}; i < 16uz; ++i) fake.receive();
+
+  ASSERT_EQ(size(fake._writes), 1uz);
+  EXPECT_EQ(fake._writes.front(), std::pair(8u, uint8_t{3u}));
+}
+
+#endif
+
+#if ZUSI_RX_CV_READ
+TEST(RxStaticBase, cv_read) {
+  StaticRxFake fake;
+  auto const packet{zusi::make_cv_read_packet(0u, 42u)};
+  fake._rx.assign(cbegin(packet), cend(packet));
+  fake._rx.push_back(zusi::resync_byte);
+
+  for (auto i{0uz}; i < 16uz; ++i) fake.receive();
+
+  // ACK (low, high), busy (low, high), CV value and CRC8
+  ASSERT_EQ(size(fake._tx), 4uz + 2uz * CHAR_BIT);
+  uint8_t value{};
+  for (auto i{0uz}; i < CHAR_BIT; ++i)
+    value = static_cast<uint8_t>(value | fake._tx[4uz + i] << i);
+  EXPECT_EQ(value, 42u);
+}
+#endif
+
+#if ZUSI_RX_ZPP_COPY
+TEST(RxStaticBase, zpp_copy) {
+  StaticRxFake fake;
+  auto const packet{
+    zusi::make_zpp_copy_packet(0x0001'0000u, 0x0001'0400u, 0x200u)};
+  fake._rx.assign(cbegin(packet), cend(packet));
+  fake._rx.push_back(zusi::resync_byte);
+
+  for (auto i{0uz}; i < 16uz; ++i) fake.receive();
+
+  ASSERT_EQ(size(fake._copies), 1uz);
+  EXPECT_EQ(fake._copies.front(),
+            (std::array{0x0001'0000u, 0x0001'0400u, 0x200u}));
+}
+#endif
+
+#if ZUSI_RX_ZPP_CRC32_QUERY
+TEST(RxStaticBase, zpp_crc32_query) {
+  StaticRxFake fake;
+  auto const packet{zusi::make_zpp_crc32_query_packet(0x0001'0000u, 0x100u)};
+  fake._rx.assign(cbegin(packet), cend(packet));
+  fake._rx.push_back(zusi::resync_byte);
+
+  for (auto i{0uz}; i < 16uz; ++i) fake.receive();
+
+  // ACK (low, high), busy (low, high), CRC32 and CRC8
+  ASSERT_EQ(size(fake._tx), 4uz + 5uz * CHAR_BIT);
+  std::array<uint8_t, 4uz> bytes{};
+  for (auto i{0uz}; i < size(bytes) * CHAR_BIT; ++i)
+    bytes[i / CHAR_BIT] |=
+      static_cast<uint8_t>(fake._tx[4uz + i] << i % CHAR_BIT);
+  EXPECT_EQ(zusi::data2uint32(cbegin(bytes)), 0x0001'0100u);
+}
+#endif
@@ -0,0 +1,52 @@
+#include "rx_test.hpp"
+
+#if ZUSI_RX_CV_READ
+namespace {
+
+// Record a CV read answered with value
+std::vector<uint8_t> record_cv_read(uint8_t value) {
+  NiceMock<RxMock> mock;
+  zusi::Packet packet{
+    std::to_underlying(zusi::Command::CvRead), 0u, 0u, 0u, 0u, 0u};
+  EXPECT_CALL(mock, receiveByte())
+    .WillOnce(Return(packet[0uz]))
+    .WillOnce(Return(packet[1uz]))
+    .WillOnce(Return(packet[2uz]))
+    .WillOnce(Return(packet[3uz]))
+    .WillOnce(Return(packet[4uz]))
+    .WillOnce(Return(packet[5uz]))
+    .WillOnce(Return(zusi::crc8(packet)))
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(mock, readCv(0u)).WillOnce(Return(value));
+
+  std::vector<uint8_t> trace;
+  zusi::rx::Recorder recorder{mock, trace};
+  for (auto i{0uz}; i < 16uz; ++i) recorder.receive();
+  return trace;
+}
+
+} // namespace
+
+TEST(RxTrace, record_replay) {
+  auto const trace{record_cv_read(42u)};
+
+  NiceMock<RxMock> mock;
+  EXPECT_CALL(mock, readCv(0u)).WillOnce(Return(42u));
+  EXPECT_CALL(mock, toggleLights()).Times(AtLeast(1));
+  EXPECT_CALL(mock, receiveByte()).Times(0);
+  EXPECT_CALL(mock, writeData(_)).Times(0);
+  zusi::rx::Replayer replayer{mock, trace};
+  EXPECT_FALSE(replayer.run());
+}
+
+TEST(RxTrace, replay_mismatch) {
+  auto const trace{record_cv_read(42u)};
+
+  NiceMock<RxMock> mock;
+  EXPECT_CALL(mock, readCv(0u)).WillOnce(Return(43u));
+  zusi::rx::Replayer replayer{mock, trace};
+  EXPECT_TRUE(replayer.run());
+}
+#endif
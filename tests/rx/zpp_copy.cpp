@@ -0,0 +1,80 @@
+#include "rx_test.hpp"
+
+#if ZUSI_RX_ZPP_COPY
+using namespace std::chrono_literals;
+
+TEST_F(RxTest, zpp_copy) {
+  auto const packet{
+    zusi::make_zpp_copy_packet(0x0001'0000u, 0x0001'0400u, 0x200u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, addressValid(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, copyZpp(0x0001'0000u, 0x0001'0400u, 0x200u));
+  EXPECT_CALL(_mock, writeData(_))
+    .Times(Exactly(1 +  // ack_valid
+                   1 +  // ack
+                   1 +  // busy
+                   1)); // busy
+
+  RunFor(100ms);
+}
+
+TEST_F(RxTest, zpp_copy_invalid_address) {
+  auto const packet{zusi::make_zpp_copy_packet(0x0001'0000u, 0u, 0x100u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, addressValid(0x0001'0000u)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, addressValid(0u)).WillRepeatedly(Return(false));
+  EXPECT_CALL(_mock, copyZpp(_, _, _)).Times(0);
+  std::vector<bool> bits;
+  EXPECT_CALL(_mock, writeData(_)).WillRepeatedly([&](bool state) {
+    bits.push_back(state);
+  });
+
+  RunFor(100ms);
+
+  // ACK valid only, data stays low for NAK
+  EXPECT_EQ(bits, std::vector<bool>{false});
+}
+
+TEST_F(RxTest, zpp_copy_not_supported) {
+  auto const packet{
+    zusi::make_zpp_copy_packet(0x0001'0000u, 0x0001'0400u, 0x200u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, addressValid(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, features())
+    .WillRepeatedly(Return(zusi::Features{0xFFu, 0xFFu, 0xFFu, 0xFFu}));
+  EXPECT_CALL(_mock, copyZpp(_, _, _)).Times(0);
+  std::vector<bool> bits;
+  EXPECT_CALL(_mock, writeData(_)).WillRepeatedly([&](bool state) {
+    bits.push_back(state);
+  });
+
+  RunFor(100ms);
+
+  // ACK valid only, data stays low for NAK
+  EXPECT_EQ(bits, std::vector<bool>{false});
+}
+#endif
@@ -0,0 +1,59 @@
+#include "rx_test.hpp"
+
+#if ZUSI_RX_ZPP_CRC32_QUERY
+using namespace std::chrono_literals;
+
+TEST_F(RxTest, zpp_crc32_query) {
+  auto const packet{zusi::make_zpp_crc32_query_packet(0x0001'0000u, 0x100u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, crc32Zpp(0x0001'0000u, 0x100u))
+    .WillOnce(Return(0x1234'5678u));
+  std::vector<bool> bits;
+  EXPECT_CALL(_mock, writeData(_)).WillRepeatedly([&](bool state) {
+    bits.push_back(state);
+  });
+
+  RunFor(100ms);
+
+  // ACK valid, ACK, busy, busy, CRC32 and CRC8
+  ASSERT_EQ(size(bits), 4uz + 5uz * CHAR_BIT);
+  std::array<uint8_t, 5uz> bytes{};
+  for (auto i{0uz}; i < size(bytes) * CHAR_BIT; ++i)
+    bytes[i / CHAR_BIT] |= static_cast<uint8_t>(bits[4uz + i] << i % CHAR_BIT);
+  EXPECT_EQ(zusi::data2uint32(cbegin(bytes)), 0x1234'5678u);
+  EXPECT_EQ(bytes[4uz], zusi::crc8(std::span{bytes}.first<4uz>()));
+}
+
+TEST_F(RxTest, zpp_crc32_query_not_supported) {
+  auto const packet{zusi::make_zpp_crc32_query_packet(0x0001'0000u, 0x100u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, features())
+    .WillRepeatedly(Return(zusi::Features{0xFFu, 0xFFu, 0xFFu, 0xFFu}));
+  EXPECT_CALL(_mock, crc32Zpp(_, _)).Times(0);
+  std::vector<bool> bits;
+  EXPECT_CALL(_mock, writeData(_)).WillRepeatedly([&](bool state) {
+    bits.push_back(state);
+  });
+
+  RunFor(100ms);
+
+  // ACK valid only, data stays low for NAK
+  EXPECT_EQ(bits, std::vector<bool>{false});
+}
+#endif
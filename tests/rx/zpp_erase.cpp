@@ -1,5 +1,6 @@
 #include "rx_test.hpp"
 
+#if ZUSI_RX_COMMAND(0x04u)
 using namespace std::chrono_literals;
 
 TEST_F(RxTest, zpp_erase) {
@@ -24,3 +25,4 @@ TEST_F(RxTest, zpp_erase) {
 
   RunFor(100ms);
 }
+#endif
@@ -1,5 +1,6 @@
 #include "rx_test.hpp"
 
+#if ZUSI_RX_ZPP_LC_DC_QUERY
 using namespace std::chrono_literals;
 
 TEST_F(RxTest, zpp_lc_dc_query) {
@@ -43,3 +44,4 @@ TEST_F(RxTest, zpp_lc_dc_query) {
 
   RunFor(100ms);
 }
+#endif
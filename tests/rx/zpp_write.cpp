@@ -0,0 +1,84 @@
+#include <numeric>
+#include "rx_test.hpp"
+
+#if ZUSI_RX_COMMAND(0x05u)
+using namespace std::chrono_literals;
+
+namespace {
+
+zusi::Packet make_packet(uint32_t addr) {
+  std::array<uint8_t, 256uz> bytes{};
+  std::iota(begin(bytes), end(bytes), 0u);
+  return zusi::make_zpp_write_packet(255u, addr, bytes);
+}
+
+} // namespace
+
+#if ZUSI_RX_CHUNK_SIZE
+TEST_F(RxTest, zpp_write_stream) {
+  auto const packet{make_packet(0x0001'0000u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, addressValid(0x0001'0000u)).WillOnce(Return(true));
+
+  // Chunks cover the whole block in order
+  uint32_t next_addr{0x0001'0000u};
+  uint8_t next_value{};
+  EXPECT_CALL(_mock, stageZpp(_, _))
+    .Times(static_cast<int>((256uz + ZUSI_RX_CHUNK_SIZE - 1uz) /
+                            ZUSI_RX_CHUNK_SIZE))
+    .WillRepeatedly([&](uint32_t addr, std::span<uint8_t const> bytes) {
+      EXPECT_EQ(addr, next_addr);
+      EXPECT_LE(size(bytes), ZUSI_RX_CHUNK_SIZE);
+      for (auto const byte : bytes) EXPECT_EQ(byte, next_value++);
+      next_addr += static_cast<uint32_t>(size(bytes));
+    });
+  EXPECT_CALL(_mock, commitZpp()).Times(1);
+  EXPECT_CALL(_mock, discardZpp()).Times(0);
+
+  RunFor(100ms);
+}
+
+TEST_F(RxTest, zpp_write_stream_discard_on_crc_error) {
+  auto packet{make_packet(0x0001'0000u)};
+  packet.back() = static_cast<uint8_t>(~packet.back());
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, commitZpp()).Times(0);
+  EXPECT_CALL(_mock, discardZpp()).Times(1);
+
+  RunFor(100ms);
+}
+#else
+TEST_F(RxTest, zpp_write) {
+  auto const packet{make_packet(0x0001'0000u)};
+
+  Sequence seq;
+  for (auto const byte : packet)
+    EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+  EXPECT_CALL(_mock, receiveByte())
+    .InSequence(seq)
+    .WillOnce(Return(zusi::resync_byte))
+    .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(_mock, addressValid(0x0001'0000u)).WillOnce(Return(true));
+  EXPECT_CALL(_mock, writeZpp(0x0001'0000u, SizeIs(256uz))).Times(1);
+
+  RunFor(100ms);
+}
+#endif
+#endif
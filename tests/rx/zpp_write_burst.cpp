@@ -0,0 +1,163 @@
+#include <deque>
+#include <numeric>
+#include "rx_test.hpp"
+
+#if ZUSI_RX_COMMAND(0x08u)
+namespace {
+
+// Header and blocks of a burst followed by resync
+std::vector<uint8_t> make_burst(uint32_t addr, size_t count) {
+  auto const header{
+    zusi::make_zpp_write_burst_frame(static_cast<uint8_t>(count - 1uz), addr)};
+  std::vector<uint8_t> bytes(cbegin(header), cend(header));
+  for (auto i{0uz}; i < count; ++i) {
+    std::array<uint8_t, zusi::zpp_write_burst_block_size> block{};
+    std::iota(begin(block), end(block), static_cast<uint8_t>(i));
+    auto const frame{zusi::make_zpp_write_burst_block(block)};
+    bytes.insert(end(bytes), cbegin(frame), cend(frame));
+  }
+  bytes.push_back(zusi::resync_byte);
+  return bytes;
+}
+
+} // namespace
+
+// Bytes are served from a queue, a burst is too long for a sequence of
+// expectations
+class RxBurstTest : public RxTest {
+protected:
+  void Receive(std::vector<uint8_t> const& bytes) {
+    _bytes.assign(cbegin(bytes), cend(bytes));
+    EXPECT_CALL(_mock, receiveByte())
+      .WillRepeatedly([this]() -> std::optional<uint8_t> {
+        if (empty(_bytes)) return std::nullopt;
+        auto const byte{_bytes.front()};
+        _bytes.pop_front();
+        return byte;
+      });
+    EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(_mock, addressValid(_)).WillRepeatedly(Return(true));
+  }
+
+  // Run until all bytes are consumed and the command has been executed
+  void Run() {
+    while (!empty(_bytes)) _mock.receive();
+    for (auto i{0uz}; i < 16uz; ++i) _mock.receive();
+  }
+
+  std::deque<uint8_t> _bytes;
+};
+
+#if ZUSI_RX_CHUNK_SIZE
+TEST_F(RxBurstTest, zpp_write_burst) {
+  Receive(make_burst(0x0001'0000u, 3uz));
+
+  size_t staged{};
+  EXPECT_CALL(_mock, stageZpp(_, _))
+    .WillRepeatedly([&](uint32_t addr, std::span<uint8_t const> bytes) {
+      EXPECT_EQ(addr, 0x0001'0000u + staged);
+      staged += size(bytes);
+    });
+  // Every block gets committed on its own
+  EXPECT_CALL(_mock, commitZpp()).Times(3);
+  EXPECT_CALL(_mock, discardZpp()).Times(0);
+
+  Run();
+  EXPECT_EQ(staged, 3uz * zusi::zpp_write_burst_block_size);
+}
+
+TEST_F(RxBurstTest, zpp_write_burst_crc_error) {
+  auto bytes{make_burst(0x0001'0000u, 3uz)};
+  bytes[7uz + 257uz + 12uz] ^= 0xFFu;
+  Receive(bytes);
+
+  // Only blocks in front of the broken one get committed
+  EXPECT_CALL(_mock, commitZpp()).Times(1);
+  EXPECT_CALL(_mock, discardZpp()).Times(2);
+
+  Run();
+}
+#else
+TEST_F(RxBurstTest, zpp_write_burst) {
+  Receive(make_burst(0x0001'0000u, 3uz));
+
+  Sequence seq;
+  for (auto i{0u}; i < 3u; ++i)
+    EXPECT_CALL(_mock, writeZpp(0x0001'0000u + i * 256u, SizeIs(256uz)))
+      .InSequence(seq)
+      .WillOnce([i](uint32_t, std::span<uint8_t const> bytes) {
+        EXPECT_EQ(bytes.front(), i);
+      });
+
+  Run();
+}
+
+// Every block gets written while data is pulled low during its busy phase
+TEST_F(RxBurstTest, zpp_write_burst_busy_per_block) {
+  Receive(make_burst(0x0001'0000u, 2uz));
+
+  std::vector<char> events;
+  EXPECT_CALL(_mock, writeData(_)).WillRepeatedly([&](bool state) {
+    events.push_back(state ? 'H' : 'L');
+  });
+  EXPECT_CALL(_mock, writeZpp(_, _)).WillRepeatedly([&] {
+    events.push_back('W');
+  });
+
+  Run();
+
+  ASSERT_GE(size(events), 6uz);
+  EXPECT_EQ((std::vector<char>{cbegin(events), cbegin(events) + 6}),
+            (std::vector<char>{'L', 'W', 'H', 'L', 'W', 'H'}));
+}
+
+TEST_F(RxBurstTest, zpp_write_burst_crc_error) {
+  auto bytes{make_burst(0x0001'0000u, 3uz)};
+  bytes[7uz + 257uz + 12uz] ^= 0xFFu;
+  Receive(bytes);
+
+  // Only blocks in front of the broken one get written
+  EXPECT_CALL(_mock, writeZpp(0x0001'0000u, _)).Times(1);
+  EXPECT_CALL(_mock, writeZpp(Ne(0x0001'0000u), _)).Times(0);
+
+  Run();
+}
+#endif
+
+TEST_F(RxBurstTest, zpp_write_burst_invalid_address) {
+  Receive(make_burst(0x0001'0000u, 2uz));
+  EXPECT_CALL(_mock, addressValid(0x0001'0100u)).WillOnce(Return(false));
+#if ZUSI_RX_CHUNK_SIZE
+  EXPECT_CALL(_mock, commitZpp()).Times(1);
+  EXPECT_CALL(_mock, discardZpp()).Times(1);
+#else
+  EXPECT_CALL(_mock, writeZpp(0x0001'0000u, _)).Times(1);
+  EXPECT_CALL(_mock, writeZpp(0x0001'0100u, _)).Times(0);
+#endif
+
+  Run();
+}
+
+TEST_F(RxBurstTest, zpp_write_burst_header_crc_error) {
+  // Blocks would otherwise be parsed as commands after the error
+  auto bytes{make_burst(0x0001'0000u, 1uz)};
+  bytes.resize(zusi::data_pos + 1uz);
+  bytes[zusi::addr_pos] ^= 0xFFu;
+  Receive(bytes);
+#if ZUSI_RX_EVENT_LOG_SIZE
+  EXPECT_CALL(_mock, timestamp()).WillRepeatedly(Return(0u));
+#endif
+#if ZUSI_RX_CHUNK_SIZE
+  EXPECT_CALL(_mock, stageZpp(_, _)).Times(0);
+  EXPECT_CALL(_mock, commitZpp()).Times(0);
+#else
+  EXPECT_CALL(_mock, writeZpp(_, _)).Times(0);
+#endif
+
+  Run();
+
+#if ZUSI_RX_EVENT_LOG_SIZE
+  EXPECT_GE(_mock.eventLog().errors(zusi::rx::Cause::CrcError), 1u);
+#endif
+}
+#endif
@@ -0,0 +1,74 @@
+#include "rx_test.hpp"
+
+#if ZUSI_RX_COMMAND(0x09u) && ZUSI_RX_ZPP_WRITE
+using namespace std::chrono_literals;
+
+namespace {
+
+// Compressed block of 256 bytes 0x00-0x0F repeating
+zusi::Packet make_packet(uint32_t addr) {
+  std::array<uint8_t, 256uz> bytes{};
+  for (auto i{0uz}; i < size(bytes); ++i)
+    bytes[i] = static_cast<uint8_t>(i % 16uz);
+  std::array<uint8_t, 255uz> compressed{};
+  auto const count{zusi::compress(bytes, compressed)};
+  return zusi::make_zpp_write_compressed_packet(
+    addr, std::span{compressed}.first(count));
+}
+
+} // namespace
+
+class RxCompressedTest : public RxTest {
+protected:
+  void Receive(zusi::Packet const& packet) {
+    Sequence seq;
+    for (auto const byte : packet)
+      EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+    EXPECT_CALL(_mock, receiveByte())
+      .InSequence(seq)
+      .WillOnce(Return(zusi::resync_byte))
+      .WillRepeatedly(Return(std::nullopt));
+    EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(_mock, addressValid(_)).WillRepeatedly(Return(true));
+  }
+};
+
+#if ZUSI_RX_CHUNK_SIZE
+// Decompressing requires the whole block which chunk mode does not buffer
+TEST_F(RxCompressedTest, zpp_write_compressed_not_supported) {
+  Receive(make_packet(0x0001'0000u));
+  EXPECT_CALL(_mock, stageZpp(_, _)).Times(0);
+  EXPECT_CALL(_mock, commitZpp()).Times(0);
+
+  RunFor(100ms);
+}
+#else
+TEST_F(RxCompressedTest, zpp_write_compressed) {
+  Receive(make_packet(0x0001'0000u));
+  EXPECT_CALL(_mock, writeZpp(0x0001'0000u, SizeIs(256uz)))
+    .WillOnce([](uint32_t, std::span<uint8_t const> bytes) {
+      for (auto i{0uz}; i < size(bytes); ++i) EXPECT_EQ(bytes[i], i % 16uz);
+    });
+
+  RunFor(100ms);
+}
+
+TEST_F(RxCompressedTest, zpp_write_compressed_crc_error) {
+  auto packet{make_packet(0x0001'0000u)};
+  packet.back() = static_cast<uint8_t>(~packet.back());
+  Receive(packet);
+  EXPECT_CALL(_mock, writeZpp(_, _)).Times(0);
+
+  RunFor(100ms);
+}
+
+TEST_F(RxCompressedTest, zpp_write_compressed_malformed) {
+  // Copy references data in front of the block
+  std::array<uint8_t, 2uz> const compressed{0xC0u, 0x10u};
+  Receive(zusi::make_zpp_write_compressed_packet(0x0001'0000u, compressed));
+  EXPECT_CALL(_mock, writeZpp(_, _)).Times(0);
+
+  RunFor(100ms);
+}
+#endif
+#endif
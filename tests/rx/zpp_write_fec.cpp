@@ -0,0 +1,102 @@
+#include <numeric>
+#include "rx_test.hpp"
+
+#if ZUSI_RX_COMMAND(0x0Eu) && ZUSI_RX_ZPP_WRITE
+using namespace std::chrono_literals;
+
+namespace {
+
+// ZPP-Write-FEC packet followed by its parity
+std::vector<uint8_t> make_frame(uint32_t addr) {
+  std::array<uint8_t, 256uz> bytes{};
+  std::iota(begin(bytes), end(bytes), 0u);
+  auto const packet{zusi::make_zpp_write_fec_packet(255u, addr, bytes)};
+  auto const parity{zusi::make_zpp_write_fec_parity(packet)};
+  std::vector<uint8_t> frame{cbegin(packet), cend(packet)};
+  frame.insert(end(frame), cbegin(parity), cend(parity));
+  return frame;
+}
+
+} // namespace
+
+class RxFecTest : public RxTest {
+protected:
+  void Receive(std::vector<uint8_t> const& frame) {
+    Sequence seq;
+    for (auto const byte : frame)
+      EXPECT_CALL(_mock, receiveByte()).InSequence(seq).WillOnce(Return(byte));
+    EXPECT_CALL(_mock, receiveByte())
+      .InSequence(seq)
+      .WillOnce(Return(zusi::resync_byte))
+      .WillRepeatedly(Return(std::nullopt));
+    EXPECT_CALL(_mock, waitClock(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(_mock, addressValid(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(_mock, writeData(_)).WillRepeatedly([this](bool state) {
+      _bits.push_back(state);
+    });
+  }
+
+  std::vector<bool> _bits;
+};
+
+#if ZUSI_RX_CHUNK_SIZE
+// Correcting requires the whole block which chunk mode does not buffer
+TEST_F(RxFecTest, zpp_write_fec_not_supported) {
+  Receive(make_frame(0x0001'0000u));
+  EXPECT_CALL(_mock, commitZpp()).Times(0);
+
+  RunFor(100ms);
+}
+#else
+TEST_F(RxFecTest, zpp_write_fec) {
+  Receive(make_frame(0x0001'0000u));
+  EXPECT_CALL(_mock, writeZpp(0x0001'0000u, SizeIs(256uz)))
+    .WillOnce([](uint32_t, std::span<uint8_t const> bytes) {
+      for (auto i{0uz}; i < size(bytes); ++i) EXPECT_EQ(bytes[i], i);
+    });
+
+  RunFor(100ms);
+  ASSERT_GE(size(_bits), 2uz);
+  EXPECT_TRUE(_bits[1uz]); // ACK
+}
+
+TEST_F(RxFecTest, zpp_write_fec_corrects_errors) {
+  auto frame{make_frame(0x0001'0000u)};
+  frame[zusi::addr_pos] ^= 0x40u;         // Address
+  frame[zusi::data_pos + 17uz] ^= 0x01u;  // Data
+  frame[zusi::data_pos + 256uz] ^= 0x08u; // CRC8
+  Receive(frame);
+  EXPECT_CALL(_mock, writeZpp(0x0001'0000u, SizeIs(256uz)))
+    .WillOnce([](uint32_t, std::span<uint8_t const> bytes) {
+      for (auto i{0uz}; i < size(bytes); ++i) EXPECT_EQ(bytes[i], i);
+    });
+
+  RunFor(100ms);
+  ASSERT_GE(size(_bits), 2uz);
+  EXPECT_TRUE(_bits[1uz]); // ACK
+}
+
+TEST_F(RxFecTest, zpp_write_fec_uncorrectable) {
+  auto frame{make_frame(0x0001'0000u)};
+  frame[zusi::data_pos + 17uz] ^= 0x01u;
+  frame[zusi::data_pos + 18uz] ^= 0x01u;
+  Receive(frame);
+  EXPECT_CALL(_mock, writeZpp(_, _)).Times(0);
+
+  RunFor(100ms);
+  // ACK valid only, data stays low for NAK
+  EXPECT_EQ(_bits, std::vector<bool>{false});
+}
+
+// Size is needed before the parity arrives, so it can't be corrected
+TEST_F(RxFecTest, zpp_write_fec_size_not_corrected) {
+  auto frame{make_frame(0x0001'0000u)};
+  frame[zusi::data_cnt_pos] ^= 0x01u;
+  Receive(frame);
+  EXPECT_CALL(_mock, writeZpp(_, _)).Times(0);
+
+  RunFor(100ms);
+  EXPECT_THAT(_bits, Each(false));
+}
+#endif
+#endif
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <zusi/zusi.hpp>
+
+using zusi::trace::Event;
+using zusi::trace::Type;
+using namespace std::chrono_literals;
+
+TEST(trace, write_read) {
+  std::array<uint8_t, 3uz> const bytes{0x01u, 0x02u, 0x03u};
+  std::vector<uint8_t> trace;
+  zusi::trace::Writer writer{trace};
+  writer.write({.type = Type::TransmitBytes,
+                .mbps = zusi::Mbps::_1_807,
+                .time = 1us,
+                .bytes = bytes});
+  writer.write({.type = Type::ReadData, .state = true, .time = 1ms});
+  writer.write({.type = Type::DelayUs, .time = 1s, .value = 10'000u});
+  writer.write({.type = Type::ReceiveByte, .time = 1s});
+
+  zusi::trace::Reader reader{trace};
+  auto const tx{reader.next()};
+  ASSERT_TRUE(tx);
+  EXPECT_EQ(tx->type, Type::TransmitBytes);
+  EXPECT_EQ(tx->mbps, zusi::Mbps::_1_807);
+  EXPECT_EQ(tx->time, 1us);
+  EXPECT_TRUE(std::ranges::equal(tx->bytes, bytes));
+  auto const read{reader.next()};
+  ASSERT_TRUE(read);
+  EXPECT_TRUE(read->state);
+  EXPECT_EQ(read->time, 1ms);
+  auto const delay{reader.next()};
+  ASSERT_TRUE(delay);
+  EXPECT_EQ(delay->value, 10'000u);
+  EXPECT_EQ(delay->time, 1s);
+  auto const rx{reader.next()};
+  ASSERT_TRUE(rx);
+  EXPECT_FALSE(rx->state);
+  EXPECT_TRUE(empty(rx->bytes));
+  EXPECT_FALSE(reader.next());
+  EXPECT_FALSE(reader.error());
+}
+
+TEST(trace, malformed) {
+  std::vector<uint8_t> trace;
+  zusi::trace::Writer writer{trace};
+  std::array<uint8_t, 8uz> const bytes{};
+  writer.write({.type = Type::TransmitBytes, .bytes = bytes});
+  trace.pop_back();
+
+  zusi::trace::Reader reader{trace};
+  EXPECT_FALSE(reader.next());
+  EXPECT_TRUE(reader.error());
+  EXPECT_TRUE(zusi::trace::Reader{{}}.error());
+}
+
+TEST(trace, first_mismatch_ignores_timing) {
+  std::vector<uint8_t> a, b;
+  zusi::trace::Writer wa{a}, wb{b};
+  wa.write({.type = Type::WriteClock, .state = true, .time = 1us});
+  wb.write({.type = Type::WriteClock, .state = true, .time = 5us});
+  EXPECT_FALSE(zusi::trace::first_mismatch(a, b));
+
+  wa.write({.type = Type::WriteData, .state = true});
+  wb.write({.type = Type::WriteData, .state = false});
+  EXPECT_EQ(zusi::trace::first_mismatch(a, b), 1uz);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <zusi/tx/arbiter.hpp>
+#include "tx_fake.hpp"
+
+using Priority = zusi::tx::Arbiter::Priority;
+
+namespace {
+
+// Command, address and count of recorded frame
+struct Frame {
+  zusi::Command cmd{};
+  uint32_t addr{};
+  size_t count{};
+};
+
+Frame frame(std::vector<uint8_t> const& bytes) {
+  return {static_cast<zusi::Command>(bytes[zusi::cmd_pos]),
+          zusi::data2uint32(&bytes[zusi::addr_pos]),
+          bytes[zusi::data_cnt_pos] + 1uz};
+}
+
+} // namespace
+
+TEST(Arbiter, futures_complete_on_poll) {
+  TxFake fake;
+  fake._cvs[8uz] = 145u;
+  zusi::tx::Arbiter arbiter{fake};
+
+  auto read{arbiter.readCv(8u)};
+  auto write{arbiter.writeCv(9u, 42u)};
+  EXPECT_EQ(read.wait_for(std::chrono::seconds{0}),
+            std::future_status::timeout);
+  EXPECT_EQ(arbiter.poll(), 2uz);
+
+  EXPECT_EQ(read.get(), 145u);
+  EXPECT_TRUE(write.get());
+  EXPECT_EQ(fake._cvs[9uz], 42u);
+  EXPECT_EQ(arbiter.poll(), 0uz);
+}
+
+TEST(Arbiter, interactive_before_bulk) {
+  TxFake fake;
+  zusi::tx::Arbiter arbiter{fake};
+
+  auto const packet{
+    zusi::make_zpp_write_packet(0u, 0u, std::array<uint8_t, 1uz>{0xAAu})};
+  auto transmit{arbiter.transmit(packet)};
+  auto job{false};
+  arbiter.submit([&](zusi::tx::Base&) { job = true; });
+  auto read{arbiter.readCv(8u)};
+  arbiter.poll();
+
+  ASSERT_EQ(size(fake._frames), 2uz);
+  EXPECT_EQ(frame(fake._frames[0uz]).cmd, zusi::Command::CvRead);
+  EXPECT_EQ(frame(fake._frames[1uz]).cmd, zusi::Command::ZppWrite);
+  EXPECT_TRUE(job);
+  EXPECT_TRUE(read.get());
+  EXPECT_TRUE(transmit.get());
+}
+
+TEST(Arbiter, merge_cv_reads) {
+  TxFake fake;
+  for (auto i{0uz}; i < size(fake._cvs); ++i)
+    fake._cvs[i] = static_cast<uint8_t>(i);
+  ASSERT_TRUE(fake.capabilities(true));
+  fake._frames.clear();
+  zusi::tx::Arbiter arbiter{fake, 4uz};
+
+  std::vector<std::future<std::expected<uint8_t, std::errc>>> reads;
+  for (auto const addr : {10u, 11u, 11u, 12u, 10u, 13u, 14u, 20u})
+    reads.push_back(arbiter.readCv(addr));
+  arbiter.poll();
+
+  // 10-13, 14, 20
+  ASSERT_EQ(size(fake._frames), 3uz);
+  EXPECT_EQ(frame(fake._frames[0uz]).addr, 10u);
+  EXPECT_EQ(frame(fake._frames[0uz]).count, 4uz);
+  EXPECT_EQ(frame(fake._frames[1uz]).addr, 14u);
+  EXPECT_EQ(frame(fake._frames[2uz]).addr, 20u);
+  EXPECT_EQ(reads[3uz].get(), 12u);
+  EXPECT_EQ(reads[4uz].get(), 10u);
+  EXPECT_EQ(reads[5uz].get(), 13u);
+  EXPECT_EQ(reads[7uz].get(), 20u);
+}
+
+TEST(Arbiter, merge_duplicate_cv_reads_only) {
+  TxFake fake;
+  zusi::tx::Arbiter arbiter{fake};
+
+  arbiter.readCv(10u);
+  arbiter.readCv(10u);
+  arbiter.readCv(11u);
+  arbiter.poll();
+
+  ASSERT_EQ(size(fake._frames), 2uz);
+  EXPECT_EQ(frame(fake._frames[0uz]).count, 1uz);
+  EXPECT_EQ(frame(fake._frames[1uz]).count, 1uz);
+}
+
+TEST(Arbiter, merge_consecutive_cv_writes) {
+  TxFake fake;
+  ASSERT_TRUE(fake.capabilities(true));
+  fake._frames.clear();
+  zusi::tx::Arbiter arbiter{fake, 256uz};
+
+  auto first{arbiter.writeCv(30u, 1u)};
+  arbiter.writeCv(31u, 2u);
+  arbiter.writeCv(32u, 3u);
+  // Not consecutive
+  arbiter.writeCv(32u, 4u);
+  // Other priority
+  auto last{arbiter.writeCv(33u, 5u, Priority::Normal)};
+  arbiter.poll();
+
+  ASSERT_EQ(size(fake._frames), 3uz);
+  EXPECT_EQ(frame(fake._frames[0uz]).addr, 30u);
+  EXPECT_EQ(frame(fake._frames[0uz]).count, 3uz);
+  EXPECT_EQ(frame(fake._frames[1uz]).addr, 32u);
+  EXPECT_EQ(frame(fake._frames[2uz]).addr, 33u);
+  EXPECT_TRUE(first.get());
+  EXPECT_TRUE(last.get());
+  EXPECT_EQ(fake._cvs[32uz], 4u);
+}
+
+TEST(Arbiter, many_producers) {
+  TxFake fake;
+  for (auto i{0uz}; i < size(fake._cvs); ++i)
+    fake._cvs[i] = static_cast<uint8_t>(i);
+  zusi::tx::Arbiter arbiter{fake, 8uz};
+  std::jthread consumer{[&](std::stop_token stoken) { arbiter.run(stoken); }};
+
+  std::array<std::vector<std::future<std::expected<uint8_t, std::errc>>>, 4uz>
+    reads;
+  {
+    std::vector<std::jthread> producers;
+    for (auto i{0uz}; i < size(reads); ++i)
+      producers.emplace_back([&, i] {
+        for (auto addr{0u}; addr < 100u; ++addr)
+          reads[i].push_back(
+            arbiter.readCv(addr, static_cast<Priority>(i % 3uz)));
+      });
+  }
+
+  for (auto& futures : reads)
+    for (auto addr{0u}; auto& read : futures) EXPECT_EQ(read.get(), addr++);
+}
+
+TEST(Arbiter, pending_requests_broken_on_destruction) {
+  TxFake fake;
+  std::future<std::expected<uint8_t, std::errc>> read;
+  {
+    zusi::tx::Arbiter arbiter{fake};
+    read = arbiter.readCv(8u);
+  }
+  EXPECT_THROW(read.get(), std::future_error);
+  EXPECT_TRUE(empty(fake._frames));
+}
@@ -0,0 +1,108 @@
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::Mbps::_1_364;
+using ::zusi::resync_byte;
+
+namespace {
+
+// Answer ACK valid, ACK, busy and then bytes bit by bit
+void respond(NiceMock<TxMock>& mock, std::vector<uint8_t> const& bytes) {
+  auto& expectation{EXPECT_CALL(mock, readData())
+                      .WillOnce(Return(false))  // ACK valid
+                      .WillOnce(Return(true))   // ACK
+                      .WillOnce(Return(true))}; // Busy
+  for (auto const byte : bytes)
+    for (auto i{0uz}; i < CHAR_BIT; ++i)
+      expectation.WillOnce(Return(static_cast<bool>(byte >> i & 1u)));
+}
+
+// Answer capabilities query with both copies
+void respond_capabilities(NiceMock<TxMock>& mock,
+                          zusi::Capabilities const& caps) {
+  auto const bytes{zusi::capabilities2data(caps)};
+  std::vector<uint8_t> response{cbegin(bytes), cend(bytes)};
+  response.insert(end(response), cbegin(bytes), cend(bytes));
+  respond(mock, response);
+}
+
+} // namespace
+
+TEST_F(TxTest, capabilities) {
+  zusi::Capabilities const caps{.zpp_write_burst = true,
+                                .fast_response = false,
+                                .cv_multiple = true,
+                                .mbps = zusi::Mbps::_1_364,
+                                .fast_timing = true,
+                                .zpp_write_burst_blocks = 32uz};
+  respond(_mock, {0b1111'1011u, 0xFFu, 0xFFu, 0xFFu}); // 1.807Mbps
+  ASSERT_TRUE(_mock.features());
+  EXPECT_CALL(_mock,
+              transmitBytes(ElementsAreArray(zusi::make_capabilities_frame()),
+                            _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1)).Times(2);
+  respond_capabilities(_mock, caps);
+
+  auto const received{_mock.capabilities(true)};
+  ASSERT_TRUE(received);
+  EXPECT_EQ(*received, caps);
+  EXPECT_EQ(_mock.timing(), zusi::tx::fast_timing);
+  EXPECT_EQ(_mock.maxCvCount(), 256uz);
+
+  // Slower common speed gets used from now on
+  EXPECT_CALL(_mock, transmitBytes(_, _1_364));
+  EXPECT_CALL(_mock, readData()).WillRepeatedly(Return(true));
+  _mock.eraseZpp();
+}
+
+TEST_F(TxTest, capabilities_copies_differ) {
+  respond(_mock, {0x01u, 0x01u, 0x01u, 0x01u, 0x01u, 0x01u, 0x01u, 0x00u});
+
+  EXPECT_EQ(_mock.capabilities().error(), std::errc::bad_message);
+  EXPECT_EQ(_mock.timing(), zusi::tx::mx644_timing);
+}
+
+// Legacy decoders don't answer Capabilities, so it must not raise the speed
+// negotiated by Features
+TEST_F(TxTest, capabilities_never_raise_speed) {
+  respond(_mock, {0b1111'1110u, 0xFFu, 0xFFu, 0xFFu}); // 0.286Mbps
+  ASSERT_TRUE(_mock.features());
+  respond_capabilities(_mock, {.mbps = zusi::Mbps::_1_807});
+  ASSERT_TRUE(_mock.capabilities());
+
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1))
+    .Times(AnyNumber());
+  EXPECT_CALL(_mock, transmitBytes(_, _0_286));
+  EXPECT_CALL(_mock, readData()).WillRepeatedly(Return(true));
+  _mock.eraseZpp();
+}
+
+TEST_F(TxTest, capabilities_drop_stale_fast_timing) {
+  _mock.timing(zusi::tx::fast_timing);
+  respond_capabilities(_mock, {.mbps = zusi::Mbps::_0_286, .fast_timing = false});
+
+  ASSERT_TRUE(_mock.capabilities(true));
+  EXPECT_EQ(_mock.timing(), zusi::tx::mx644_timing);
+}
+
+// One device answers, a legacy device stays silent and leaves all bits set, so
+// only the limits get returned and neither the fast timing nor several CVs per
+// frame must get enabled
+TEST_F(TxTest, capabilities_mixed_bus) {
+  respond(_mock, {0b1111'1011u, 0b1111'0111u, 0xFFu, 0xFFu}); // 1.807Mbps
+  ASSERT_TRUE(_mock.features());
+  respond_capabilities(_mock,
+                       {.zpp_write_burst = true,
+                        .fast_response = true,
+                        .cv_multiple = true,
+                        .mbps = zusi::Mbps::_1_807,
+                        .fast_timing = true,
+                        .zpp_write_burst_blocks = 64uz});
+
+  auto const caps{_mock.capabilities()};
+  ASSERT_TRUE(caps);
+  EXPECT_EQ(caps->zpp_write_burst_blocks, 64uz);
+  EXPECT_EQ(_mock.timing(), zusi::tx::mx644_timing);
+  EXPECT_EQ(_mock.maxCvCount(), 1uz);
+}
@@ -0,0 +1,109 @@
+#include <numeric>
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::zusi::resync_byte;
+
+namespace {
+
+// Bitwise model of a CRC unit (polynomial 0x31 reflected, no final XOR)
+uint8_t crc_unit(std::span<uint8_t const> bytes, uint8_t crc) {
+  for (auto const byte : bytes) {
+    crc ^= byte;
+    for (auto i{0uz}; i < CHAR_BIT; ++i)
+      crc = static_cast<uint8_t>(crc & 1u ? crc >> 1u ^ 0x8Cu : crc >> 1u);
+  }
+  return crc;
+}
+
+// Transmitter which accumulates CRC8 in "hardware"
+class TxCrcUnitMock : public TxMock {
+public:
+  MOCK_METHOD(uint8_t,
+              accumulateCrc8,
+              (std::span<uint8_t const>, uint8_t),
+              (const, override));
+};
+
+struct TxCrcUnitTest : ::testing::Test {
+protected:
+  TxCrcUnitTest() {
+    ON_CALL(_mock, accumulateCrc8(_, _)).WillByDefault(crc_unit);
+  }
+
+  // Acknowledge and answer bytes bit by bit
+  void respond(std::vector<uint8_t> const& bytes = {}) {
+    auto& expectation{EXPECT_CALL(_mock, readData())
+                        .WillOnce(Return(false))  // ACK valid
+                        .WillOnce(Return(true))   // ACK
+                        .WillOnce(Return(true))}; // Busy
+    for (auto const byte : bytes)
+      for (auto i{0uz}; i < CHAR_BIT; ++i)
+        expectation.WillOnce(Return(static_cast<bool>(byte >> i & 1u)));
+  }
+
+  NiceMock<TxCrcUnitMock> _mock;
+};
+
+} // namespace
+
+TEST_F(TxCrcUnitTest, zpp_write) {
+  std::array<uint8_t, 256uz> bytes;
+  std::iota(begin(bytes), end(bytes), 0u);
+  EXPECT_CALL(_mock, accumulateCrc8(SizeIs(zusi::data_pos + 256uz), 0u));
+  EXPECT_CALL(_mock,
+              transmitBytes(ElementsAreArray(zusi::make_zpp_write_packet(
+                              255u, 0x0001'0000u, bytes)),
+                            _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  respond();
+
+  EXPECT_TRUE(_mock.writeZpp(0x0001'0000u, bytes));
+}
+
+TEST_F(TxCrcUnitTest, zpp_write_burst) {
+  std::vector<uint8_t> bytes(2uz * zusi::zpp_write_burst_block_size);
+  std::iota(begin(bytes), end(bytes), 0u);
+  std::span<uint8_t const> const blocks{bytes};
+  EXPECT_CALL(_mock,
+              accumulateCrc8(SizeIs(zusi::zpp_write_burst_block_size), 0u))
+    .Times(2);
+  Sequence seq;
+  EXPECT_CALL(_mock, transmitBytes(SizeIs(7uz), _0_286)).InSequence(seq);
+  for (auto i{0uz}; i < 2uz; ++i)
+    EXPECT_CALL(
+      _mock,
+      transmitBytes(
+        ElementsAreArray(zusi::make_zpp_write_burst_block(
+          blocks.subspan(i * zusi::zpp_write_burst_block_size)
+            .first<zusi::zpp_write_burst_block_size>())),
+        _0_286))
+      .InSequence(seq);
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1))
+    .InSequence(seq);
+  respond();
+  // Busy of every block, before the ACK phase
+  EXPECT_CALL(_mock, readData())
+    .Times(2)
+    .WillRepeatedly(Return(true))
+    .RetiresOnSaturation();
+
+  EXPECT_TRUE(_mock.writeZppBurst(0x0001'0000u, bytes));
+}
+
+TEST_F(TxCrcUnitTest, cv_read_response) {
+  EXPECT_CALL(_mock, accumulateCrc8(SizeIs(2uz), 0u));
+  respond({0x42u, zusi::crc8(0x42u)});
+
+  std::array<uint8_t, 1uz> cv;
+  EXPECT_TRUE(_mock.readCv(8u, cv));
+  EXPECT_EQ(cv[0uz], 0x42u);
+}
+
+TEST_F(TxCrcUnitTest, cv_read_crc_error) {
+  respond({0x42u, static_cast<uint8_t>(~zusi::crc8(0x42u))});
+
+  std::array<uint8_t, 1uz> cv;
+  EXPECT_EQ(_mock.readCv(8u, cv).error(), std::errc::bad_message);
+}
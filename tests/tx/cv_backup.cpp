@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include "tx_fake.hpp"
+
+using zusi::tx::CvSnapshot;
+
+TEST(CvBackup, backup_restore_writes_differences) {
+  TxFake fake;
+  std::iota(begin(fake._cvs), end(fake._cvs), 0u);
+  ASSERT_TRUE(fake.capabilities(true));
+  fake._frames.clear();
+
+  auto const snapshot{zusi::tx::backup_cvs(fake, 0u, 1024uz, 256uz)};
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(size(fake._frames), 4uz);
+  EXPECT_TRUE(std::ranges::equal(snapshot->values, fake._cvs));
+
+  fake._cvs[1uz] = 0xFFu;
+  fake._cvs[2uz] = 0xFFu;
+  fake._cvs[512uz] = 0xFFu;
+  fake._frames.clear();
+  auto const written{zusi::tx::restore_cvs(fake, *snapshot, 256uz)};
+  ASSERT_TRUE(written);
+  EXPECT_EQ(*written, 3uz);
+  EXPECT_TRUE(std::ranges::equal(snapshot->values, fake._cvs));
+  EXPECT_EQ(size(fake._frames), 4uz + 2uz);
+}
+
+// Several CVs per frame by default once all decoders confirmed it
+TEST(CvBackup, cv_multiple_by_default) {
+  TxFake fake;
+  std::iota(begin(fake._cvs), end(fake._cvs), 0u);
+  ASSERT_TRUE(fake.capabilities(true));
+  fake._frames.clear();
+
+  auto const snapshot{zusi::tx::backup_cvs(fake, 0u, 16uz)};
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(size(fake._frames), 1uz);
+  EXPECT_TRUE(std::ranges::equal(snapshot->values,
+                                 std::span{fake._cvs}.first(16uz)));
+}
+
+// Legacy decoders never confirm several CVs per frame and get single CVs, even
+// for counts whose CRC8 would match a single CV followed by the idle line
+TEST(CvBackup, single_cv_decoder) {
+  TxFake fake;
+  fake._single_cv = true;
+  std::iota(begin(fake._cvs), end(fake._cvs), 0u);
+  EXPECT_EQ(fake.capabilities(true).error(), std::errc::connection_reset);
+
+  for (auto const max_count : {128uz, 255uz}) {
+    fake._frames.clear();
+    auto const snapshot{zusi::tx::backup_cvs(fake, 0u, 256uz, max_count)};
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(size(fake._frames), 256uz);
+    EXPECT_TRUE(std::ranges::equal(snapshot->values,
+                                   std::span{fake._cvs}.first(256uz)));
+  }
+
+  auto const snapshot{zusi::tx::backup_cvs(fake, 0u, 16uz)};
+  ASSERT_TRUE(snapshot);
+  fake._cvs[1uz] = 0xFFu;
+  fake._cvs[2uz] = 0xFFu;
+  fake._frames.clear();
+  auto const written{zusi::tx::restore_cvs(fake, *snapshot)};
+  ASSERT_TRUE(written);
+  EXPECT_EQ(*written, 2uz);
+  EXPECT_TRUE(std::ranges::equal(snapshot->values,
+                                 std::span{fake._cvs}.first(16uz)));
+  EXPECT_EQ(size(fake._frames), 16uz + 2uz);
+}
+
+TEST(CvBackup, out_of_range) {
+  TxFake fake;
+  EXPECT_EQ(zusi::tx::backup_cvs(fake, 1000u, 100uz).error(),
+            std::errc::invalid_argument);
+}
+
+TEST(CvBackup, serialize_deserialize) {
+  CvSnapshot const snapshot{.addr = 8u, .values = {1u, 2u, 3u}};
+  auto bytes{zusi::tx::serialize_cv_snapshot(snapshot)};
+  EXPECT_EQ(size(bytes), 4uz + 4uz + 2uz + 3uz + 4uz);
+
+  auto const deserialized{zusi::tx::deserialize_cv_snapshot(bytes)};
+  ASSERT_TRUE(deserialized);
+  EXPECT_EQ(deserialized->addr, 8u);
+  EXPECT_EQ(deserialized->values, snapshot.values);
+
+  bytes[11uz] ^= 0x01u;
+  EXPECT_EQ(zusi::tx::deserialize_cv_snapshot(bytes).error(),
+            std::errc::bad_message);
+  bytes.pop_back();
+  EXPECT_EQ(zusi::tx::deserialize_cv_snapshot(bytes).error(),
+            std::errc::invalid_argument);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include "tx_fake.hpp"
+
+using zusi::Command;
+using zusi::tx::CvCache;
+
+namespace {
+
+size_t count_frames(TxFake const& fake, Command cmd) {
+  return static_cast<size_t>(
+    std::ranges::count_if(fake._frames, [cmd](auto const& frame) {
+      return frame[zusi::cmd_pos] == std::to_underlying(cmd);
+    }));
+}
+
+} // namespace
+
+TEST(CvCache, read_hits_cache) {
+  TxFake fake;
+  fake._cvs[8uz] = 145u;
+  CvCache cache{fake};
+
+  EXPECT_EQ(cache.readCv(8u), 145u);
+  EXPECT_EQ(cache.readCv(8u), 145u);
+  EXPECT_EQ(count_frames(fake, Command::CvRead), 1uz);
+  EXPECT_EQ(cache.peek(8u), 145u);
+  EXPECT_FALSE(cache.peek(9u));
+}
+
+TEST(CvCache, write_through_repeats_known_values) {
+  TxFake fake;
+  CvCache cache{fake};
+
+  EXPECT_TRUE(cache.writeCv(3u, 42u));
+  EXPECT_EQ(fake._cvs[3uz], 42u);
+  EXPECT_FALSE(cache.dirty(3u));
+
+  // Writing the same value again can have side effects (e.g. reset)
+  EXPECT_TRUE(cache.writeCv(8u, 8u));
+  EXPECT_TRUE(cache.writeCv(8u, 8u));
+  EXPECT_EQ(count_frames(fake, Command::CvWrite), 3uz);
+}
+
+TEST(CvCache, write_back_coalesces_ranges) {
+  TxFake fake;
+  ASSERT_TRUE(fake.capabilities(true));
+  fake._frames.clear();
+  CvCache cache{fake, CvCache::Policy::WriteBack, 256uz};
+
+  for (auto addr : {12u, 10u, 11u, 40u, 13u}) cache.writeCv(addr, 0xAAu);
+  EXPECT_TRUE(cache.dirty(10u));
+  EXPECT_TRUE(fake._frames.empty());
+
+  EXPECT_TRUE(cache.flush());
+  ASSERT_EQ(count_frames(fake, Command::CvWrite), 2uz);
+  EXPECT_EQ(fake._frames[0uz][zusi::data_cnt_pos], 3u);
+  EXPECT_EQ(zusi::data2uint32(&fake._frames[0uz][zusi::addr_pos]), 10u);
+  EXPECT_EQ(fake._frames[1uz][zusi::data_cnt_pos], 0u);
+  for (auto addr : {10uz, 11uz, 12uz, 13uz, 40uz})
+    EXPECT_EQ(fake._cvs[addr], 0xAAu);
+  EXPECT_FALSE(cache.dirty(10u));
+}
+
+TEST(CvCache, prefetch_splits_at_max_count) {
+  TxFake fake;
+  std::iota(begin(fake._cvs), end(fake._cvs), 0u);
+  ASSERT_TRUE(fake.capabilities(true));
+  fake._frames.clear();
+  CvCache cache{fake, CvCache::Policy::WriteThrough, 4uz};
+
+  std::array<uint32_t, 6uz> const addrs{5u, 0u, 1u, 2u, 3u, 4u};
+  EXPECT_TRUE(cache.prefetch(addrs));
+  EXPECT_EQ(count_frames(fake, Command::CvRead), 2uz);
+  for (auto addr : addrs) EXPECT_EQ(cache.peek(addr), addr);
+
+  // Already known, no further frames
+  EXPECT_TRUE(cache.prefetch(addrs));
+  EXPECT_EQ(count_frames(fake, Command::CvRead), 2uz);
+
+  std::array<uint32_t, 1uz> const out_of_range{CvCache::cv_count};
+  EXPECT_EQ(cache.prefetch(out_of_range).error(), std::errc::invalid_argument);
+}
+
+// Legacy decoders can't confirm several CVs per frame, so they get one by one
+TEST(CvCache, legacy_decoder_single_cv_per_frame) {
+  TxFake fake;
+  fake._single_cv = true;
+  std::iota(begin(fake._cvs), end(fake._cvs), 0u);
+  EXPECT_EQ(fake.capabilities(true).error(), std::errc::connection_reset);
+  fake._frames.clear();
+  CvCache cache{fake, CvCache::Policy::WriteBack, 256uz};
+
+  std::array<uint32_t, 4uz> const addrs{0u, 1u, 2u, 3u};
+  EXPECT_TRUE(cache.prefetch(addrs));
+  EXPECT_EQ(count_frames(fake, Command::CvRead), 4uz);
+  for (auto addr : addrs) EXPECT_EQ(cache.peek(addr), addr);
+
+  for (auto addr : addrs) cache.writeCv(addr, 0xAAu);
+  EXPECT_TRUE(cache.flush());
+  EXPECT_EQ(count_frames(fake, Command::CvWrite), 4uz);
+  for (auto addr : addrs) EXPECT_EQ(fake._cvs[addr], 0xAAu);
+}
+
+TEST(CvCache, exit_flushes_and_invalidates) {
+  TxFake fake;
+  CvCache cache{fake, CvCache::Policy::WriteBack};
+
+  cache.writeCv(1u, 1u);
+  cache.writeCv(2u, 2u);
+  EXPECT_TRUE(cache.exit(0xFFu));
+  EXPECT_EQ(count_frames(fake, Command::CvWrite), 2uz);
+  EXPECT_EQ(fake._frames.back()[zusi::cmd_pos],
+            std::to_underlying(Command::Exit));
+  EXPECT_FALSE(cache.peek(1u));
+  EXPECT_FALSE(cache.dirty(2u));
+}
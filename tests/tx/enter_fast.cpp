@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <zusi/zusi.hpp>
+
+namespace {
+
+// Bus with a single device which counts clock periods to detect entry
+class EntryTx : public zusi::tx::StaticBase<EntryTx> {
+  friend zusi::tx::StaticBase<EntryTx>;
+
+public:
+  explicit EntryTx(bool fast_entry) : _fast_entry{fast_entry} {}
+
+  mutable std::vector<uint32_t> _delays{};
+  mutable size_t _queries{};
+
+private:
+  void transmitBytes(std::span<uint8_t const>, zusi::Mbps mbps) const {
+    if (mbps == zusi::Mbps::_0_1) return; // Resync
+    ++_queries;
+    _reads = 0uz;
+  }
+  void spiMaster() const {}
+  void gpioInput() const {}
+  void gpioOutput() const { _periods = 0uz; }
+  void writeClock(bool state) const { _periods += state; }
+  void writeData(bool) const {}
+  bool readData() const { return !entered() || _reads++; } // ACK valid low
+  void delayUs(uint32_t us) const { _delays.push_back(us); }
+
+  bool entered() const {
+    return _periods >= zusi::entry_periods ||
+           (_fast_entry && _periods >= zusi::fast_entry_periods);
+  }
+
+  bool _fast_entry{};
+  mutable size_t _periods{};
+  mutable size_t _reads{};
+};
+
+} // namespace
+
+TEST(EnterFast, detected) {
+  EntryTx tx{true};
+  auto const features{tx.enterFast(true)};
+  ASSERT_TRUE(features);
+  EXPECT_EQ(tx._queries, 1uz);
+  EXPECT_EQ(std::ranges::count(tx._delays, zusi::fast_entry_period_us / 2u),
+            2 * 32);
+  EXPECT_EQ(std::ranges::count(tx._delays, 5000u), 0);
+}
+
+TEST(EnterFast, falls_back_to_regular_entry) {
+  EntryTx tx{false};
+  auto const features{tx.enterFast(true)};
+  ASSERT_TRUE(features);
+  EXPECT_EQ(tx._queries, 2uz);
+  EXPECT_EQ(std::ranges::count(tx._delays, 5000u), 2 * 100);
+}
+
+// Without knowing that all devices detect fast entry, a single answer could
+// hide legacy devices which kept running
+TEST(EnterFast, regular_entry_unless_homogeneous) {
+  EntryTx tx{true};
+  auto const features{tx.enterFast()};
+  ASSERT_TRUE(features);
+  EXPECT_EQ(tx._queries, 1uz);
+  EXPECT_EQ(std::ranges::count(tx._delays, zusi::fast_entry_period_us / 2u),
+            0);
+  EXPECT_EQ(std::ranges::count(tx._delays, 5000u), 2 * 100);
+}
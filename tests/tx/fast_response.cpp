@@ -0,0 +1,157 @@
+#include "tx_test.hpp"
+
+using ::Mbps::_1_807;
+
+namespace {
+
+// Transmitter which can read the response phase with SPI
+class TxSpiMock : public TxMock {
+public:
+  MOCK_METHOD(void,
+              receiveBytes,
+              (std::span<uint8_t> bytes, Mbps mbps),
+              (const, override));
+};
+
+// Answer ACK phase and busy phase
+void expect_ack(TxSpiMock& mock, Sequence& seq) {
+  EXPECT_CALL(mock, readData()).InSequence(seq);                // ACK valid
+  EXPECT_CALL(mock, readData()).InSequence(seq).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(mock, readData()).InSequence(seq).WillOnce(Return(true)); // Busy
+}
+
+// Answer features query with command flags
+void expect_features(TxSpiMock& mock, Sequence& seq, uint8_t flags) {
+  expect_ack(mock, seq);
+  zusi::Features const features{0b1111'1011u, flags, 0xFFu, 0xFFu};
+  for (auto const byte : features)
+    for (auto i{0uz}; i < CHAR_BIT; ++i)
+      EXPECT_CALL(mock, readData())
+        .InSequence(seq)
+        .WillOnce(Return(static_cast<bool>(byte & 1u << i)));
+}
+
+// Answer capabilities query, both copies bit by bit
+void expect_capabilities(TxSpiMock& mock, Sequence& seq, bool fast_response) {
+  expect_ack(mock, seq);
+  auto const bytes{
+    zusi::capabilities2data({.fast_response = fast_response,
+                             .mbps = zusi::Mbps::_1_807})};
+  for (auto copy{0uz}; copy < 2uz; ++copy)
+    for (auto const byte : bytes)
+      for (auto i{0uz}; i < CHAR_BIT; ++i)
+        EXPECT_CALL(mock, readData())
+          .InSequence(seq)
+          .WillOnce(Return(static_cast<bool>(byte & 1u << i)));
+}
+
+} // namespace
+
+TEST(TxFastResponse, supported) {
+  NiceMock<TxSpiMock> mock;
+  Sequence seq;
+  expect_features(mock, seq, 0b1111'0111u);
+  expect_capabilities(mock, seq, true);
+  expect_ack(mock, seq);
+  EXPECT_CALL(mock, receiveBytes(SizeIs(2uz), _1_807))
+    .InSequence(seq)
+    .WillOnce([](std::span<uint8_t> bytes, Mbps) {
+      bytes[0uz] = 42u;
+      bytes[1uz] = zusi::crc8(bytes[0uz]);
+    });
+
+  auto const features{mock.features()};
+  ASSERT_TRUE(features);
+  EXPECT_TRUE(zusi::fast_response_supported(*features));
+  ASSERT_TRUE(mock.capabilities(true));
+  EXPECT_EQ(mock.readCv(0u), 42u);
+}
+
+TEST(TxFastResponse, not_supported) {
+  NiceMock<TxSpiMock> mock;
+  Sequence seq;
+  expect_features(mock, seq, 0b1111'1111u);
+  expect_ack(mock, seq);
+  uint8_t const value{42u}, crc{zusi::crc8(value)};
+  for (auto i{0uz}; i < 2uz * CHAR_BIT; ++i)
+    EXPECT_CALL(mock, readData())
+      .InSequence(seq)
+      .WillOnce(Return(static_cast<bool>(
+        (i < CHAR_BIT ? value : crc) & 1u << i % CHAR_BIT)));
+  EXPECT_CALL(mock, receiveBytes(_, _)).Times(0);
+
+  auto const features{mock.features()};
+  ASSERT_TRUE(features);
+  EXPECT_FALSE(zusi::fast_response_supported(*features));
+  EXPECT_EQ(mock.readCv(0u), 42u);
+}
+
+// Only one device of the bus advertises the fast response phase, the cleared
+// feature bit alone must not enable it
+TEST(TxFastResponse, mixed_bus) {
+  NiceMock<TxSpiMock> mock;
+  Sequence seq;
+  auto const expect_cv{[&] {
+    expect_ack(mock, seq);
+    uint8_t const value{42u}, crc{zusi::crc8(value)};
+    for (auto i{0uz}; i < 2uz * CHAR_BIT; ++i)
+      EXPECT_CALL(mock, readData())
+        .InSequence(seq)
+        .WillOnce(Return(static_cast<bool>(
+          (i < CHAR_BIT ? value : crc) & 1u << i % CHAR_BIT)));
+  }};
+  expect_features(mock, seq, 0b1111'0111u);
+  expect_cv();
+  expect_capabilities(mock, seq, false);
+  expect_cv();
+  EXPECT_CALL(mock, receiveBytes(_, _)).Times(0);
+
+  auto const features{mock.features()};
+  ASSERT_TRUE(features);
+  EXPECT_TRUE(zusi::fast_response_supported(*features));
+  EXPECT_EQ(mock.readCv(0u), 42u);
+  auto const caps{mock.capabilities()};
+  ASSERT_TRUE(caps);
+  EXPECT_FALSE(caps->fast_response);
+  EXPECT_EQ(mock.readCv(0u), 42u);
+}
+
+// One device answers Capabilities while a legacy device stays silent, without
+// the caller stating that the bus is homogeneous the phase stays disabled
+TEST(TxFastResponse, legacy_device_silent) {
+  NiceMock<TxSpiMock> mock;
+  Sequence seq;
+  expect_features(mock, seq, 0b1111'0111u);
+  expect_capabilities(mock, seq, true);
+  expect_ack(mock, seq);
+  uint8_t const value{42u}, crc{zusi::crc8(value)};
+  for (auto i{0uz}; i < 2uz * CHAR_BIT; ++i)
+    EXPECT_CALL(mock, readData())
+      .InSequence(seq)
+      .WillOnce(Return(static_cast<bool>(
+        (i < CHAR_BIT ? value : crc) & 1u << i % CHAR_BIT)));
+  EXPECT_CALL(mock, receiveBytes(_, _)).Times(0);
+
+  ASSERT_TRUE(mock.features());
+  auto const caps{mock.capabilities()};
+  ASSERT_TRUE(caps);
+  EXPECT_TRUE(caps->fast_response);
+  EXPECT_EQ(mock.readCv(0u), 42u);
+}
+
+TEST(TxFastResponse, crc_error) {
+  NiceMock<TxSpiMock> mock;
+  Sequence seq;
+  expect_features(mock, seq, 0b1111'0111u);
+  expect_capabilities(mock, seq, true);
+  expect_ack(mock, seq);
+  EXPECT_CALL(mock, receiveBytes(SizeIs(5uz), _1_807))
+    .InSequence(seq)
+    .WillOnce([](std::span<uint8_t> bytes, Mbps) {
+      std::ranges::fill(bytes, 0x55u);
+    });
+
+  ASSERT_TRUE(mock.features());
+  ASSERT_TRUE(mock.capabilities(true));
+  EXPECT_EQ(mock.crc32Query(0u, 256u).error(), std::errc::bad_message);
+}
@@ -0,0 +1,107 @@
+#include <numeric>
+#include <thread>
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::zusi::resync_byte;
+using ::zusi::tx::FramedImage;
+
+namespace {
+
+std::vector<uint8_t> make_image(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  std::iota(begin(bytes), end(bytes), 0u);
+  // Make every other block compressible
+  for (auto i{0uz}; i < size; ++i)
+    if ((i / 256uz) % 2uz) bytes[i] = 0xFFu;
+  return bytes;
+}
+
+void for_each_on_threads(size_t count, std::function<void(size_t)> const& f) {
+  std::vector<std::jthread> workers;
+  for (auto t{0uz}; t < 4uz; ++t)
+    workers.emplace_back([&, t] {
+      for (auto i{t}; i < count; i += 4uz) f(i);
+    });
+}
+
+} // namespace
+
+TEST(FramedImage, uncompressed) {
+  auto const bytes{make_image(1000uz)};
+  FramedImage const framed{0x0001'0000u, bytes};
+  ASSERT_EQ(framed.size(), 4uz);
+  for (auto i{0uz}; i < framed.size(); ++i) {
+    auto const block{std::span{bytes}.subspan(
+      i * 256uz, std::min(256uz, size(bytes) - i * 256uz))};
+    auto const addr{static_cast<uint32_t>(0x0001'0000u + i * 256uz)};
+    EXPECT_FALSE(framed.compressed(i));
+    EXPECT_TRUE(std::ranges::equal(
+      framed[i],
+      zusi::make_zpp_write_packet(
+        static_cast<uint8_t>(size(block) - 1uz), addr, block)));
+  }
+  // Last block is short
+  EXPECT_EQ(size(framed[3uz]), zusi::data_pos + 1000uz % 256uz + 1uz);
+  EXPECT_EQ(framed.arenaSize(), 4uz * (zusi::data_pos + 1uz) + 1000uz);
+}
+
+TEST(FramedImage, compressed) {
+  auto const bytes{make_image(1024uz)};
+  FramedImage const framed{0u, bytes, true};
+  ASSERT_EQ(framed.size(), 4uz);
+  for (auto i{0uz}; i < framed.size(); ++i) {
+    EXPECT_EQ(framed.compressed(i), i % 2uz == 1uz);
+    EXPECT_FALSE(zusi::crc8(framed[i]));
+  }
+  EXPECT_LT(framed.arenaSize(), 4uz * (zusi::data_pos + 257uz));
+}
+
+TEST(FramedImage, parallel_matches_sequential) {
+  auto const bytes{make_image(64uz * 256uz + 17uz)};
+  FramedImage const sequential{0u, bytes, true};
+  FramedImage const parallel{0u, bytes, true, for_each_on_threads};
+  ASSERT_EQ(sequential.size(), parallel.size());
+  for (auto i{0uz}; i < sequential.size(); ++i)
+    EXPECT_TRUE(std::ranges::equal(sequential[i], parallel[i]));
+}
+
+TEST(FramedImage, empty) {
+  FramedImage const framed{0u, {}};
+  EXPECT_EQ(framed.size(), 0uz);
+  EXPECT_EQ(framed.arenaSize(), 0uz);
+}
+
+TEST_F(TxTest, transmit_framed_packets) {
+  auto const bytes{make_image(512uz)};
+  FramedImage const framed{0u, bytes, true};
+
+  InSequence seq;
+  for (auto i{0uz}; i < framed.size(); ++i) {
+    EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(framed[i]), _0_286));
+    EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+    EXPECT_CALL(_mock, gpioInput());
+    EXPECT_CALL(_mock, readData());                        // ACK valid
+    EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+    EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+    EXPECT_CALL(_mock, spiMaster());
+  }
+
+  ASSERT_TRUE(_mock.writeZpp(framed));
+}
+
+TEST_F(TxTest, transmit_framed_packet_verbatim) {
+  auto const bytes{make_image(256uz)};
+  FramedImage const framed{0u, bytes};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(framed[0uz]), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData()); // ACK valid
+  EXPECT_CALL(_mock, readData()); // NAK
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_EQ(_mock.transmit(framed[0uz]).error(), std::errc::protocol_error);
+}
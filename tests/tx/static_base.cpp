@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include "tx_fake.hpp"
+
+namespace {
+
+// Same decoder as TxFake, but without any virtual call
+class StaticTxFake : public zusi::tx::StaticBase<StaticTxFake> {
+  friend zusi::tx::StaticBase<StaticTxFake>;
+
+public:
+  mutable std::array<uint8_t, 1024uz> _cvs{};
+  mutable std::vector<std::vector<uint8_t>> _frames{};
+
+private:
+  void transmitBytes(std::span<uint8_t const> bytes, zusi::Mbps mbps) const {
+    if (mbps == zusi::Mbps::_0_1) return; // Resync
+    _frames.emplace_back(cbegin(bytes), cend(bytes));
+    _bits.clear();
+    respond(false); // ACK valid
+    respond(true);  // ACK
+    respond(true);  // Busy
+    // Short frames (e.g. Exit) carry no address
+    if (size(bytes) < zusi::data_pos) return;
+    auto const addr{zusi::data2uint32(&bytes[zusi::addr_pos])};
+    size_t const count{bytes[zusi::data_cnt_pos] + 1uz};
+    switch (static_cast<zusi::Command>(bytes[zusi::cmd_pos])) {
+      case zusi::Command::CvRead:
+        for (auto i{0uz}; i < count; ++i) respond(_cvs[addr + i]);
+        respond(zusi::crc8({&_cvs[addr], count}));
+        break;
+      case zusi::Command::CvWrite:
+        std::copy_n(&bytes[zusi::data_pos], count, &_cvs[addr]);
+        break;
+      default: break;
+    }
+  }
+
+  void spiMaster() const {}
+  void gpioInput() const {}
+  void gpioOutput() const {}
+  void writeClock(bool) const {}
+  void writeData(bool) const {}
+
+  bool readData() const {
+    if (empty(_bits)) return true;
+    auto const bit{_bits.front()};
+    _bits.pop_front();
+    return bit;
+  }
+
+  void delayUs(uint32_t) const {}
+
+  void respond(bool bit) const { _bits.push_back(bit); }
+
+  void respond(uint8_t byte) const {
+    for (auto i{0uz}; i < CHAR_BIT; ++i)
+      respond(static_cast<bool>(byte >> i & 1u));
+  }
+
+  mutable std::deque<bool> _bits{};
+};
+
+} // namespace
+
+TEST(TxStaticBase, same_frames_as_virtual_base) {
+  TxFake dynamic_fake;
+  StaticTxFake static_fake;
+  std::array<uint8_t, 16uz> values{};
+  std::iota(begin(values), end(values), 1u);
+
+  zusi::tx::Base& base{dynamic_fake};
+  EXPECT_TRUE(base.writeCv(32u, values));
+  EXPECT_TRUE(base.writeCv(7u, 42u));
+  EXPECT_TRUE(base.exit(0x55u));
+  EXPECT_TRUE(static_fake.writeCv(32u, values));
+  EXPECT_TRUE(static_fake.writeCv(7u, 42u));
+  EXPECT_TRUE(static_fake.exit(0x55u));
+
+  EXPECT_EQ(static_fake._frames, dynamic_fake._frames);
+  EXPECT_EQ(static_fake._cvs, dynamic_fake._cvs);
+}
+
+TEST(TxStaticBase, read_cvs) {
+  StaticTxFake fake;
+  std::iota(begin(fake._cvs), end(fake._cvs), 0u);
+
+  std::array<uint8_t, 256uz> values{};
+  ASSERT_TRUE(fake.readCv(256u, values));
+  EXPECT_TRUE(std::ranges::equal(values, std::span{&fake._cvs[256uz], 256uz}));
+  EXPECT_EQ(fake.readCv(3u), 3u);
+}
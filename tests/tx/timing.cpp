@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include "tx_fake.hpp"
+
+using zusi::tx::fast_timing;
+using zusi::tx::mx644_timing;
+
+namespace {
+
+// Static transmitter defaulting to fast timing
+class FastTx : public zusi::tx::StaticBase<FastTx, fast_timing> {
+  friend zusi::tx::StaticBase<FastTx, fast_timing>;
+
+public:
+  mutable std::vector<uint32_t> _delays{};
+
+private:
+  void transmitBytes(std::span<uint8_t const>, zusi::Mbps) const {}
+  void spiMaster() const {}
+  void gpioInput() const {}
+  void gpioOutput() const {}
+  void writeClock(bool) const {}
+  void writeData(bool) const {}
+  bool readData() const { return _reads++; } // ACK valid low, then high
+  void delayUs(uint32_t us) const { _delays.push_back(us); }
+
+  mutable size_t _reads{};
+};
+
+uint32_t total(std::vector<uint32_t> const& delays) {
+  return std::accumulate(cbegin(delays), cend(delays), 0u);
+}
+
+} // namespace
+
+TEST(Timing, default_is_mx644) {
+  TxFake fake;
+  EXPECT_EQ(fake.timing(), mx644_timing);
+
+  ASSERT_TRUE(fake.writeCv(3u, 42u));
+  // Resync pauses, 2 ACK bits, busy
+  EXPECT_EQ(fake._delays,
+            (std::vector<uint32_t>{10u, 10u, 10u, 20u, 10u, 20u, 10u, 20u}));
+}
+
+TEST(Timing, runtime_profile) {
+  TxFake fake;
+  fake.timing(fast_timing);
+
+  std::array<uint8_t, 4uz> cvs{};
+  ASSERT_TRUE(fake.readCv(0u, cvs));
+  EXPECT_TRUE(std::ranges::all_of(fake._delays, [](uint32_t us) {
+    return us == 5u;
+  }));
+
+  TxFake slow;
+  ASSERT_TRUE(slow.readCv(0u, cvs));
+  EXPECT_EQ(size(slow._delays), size(fake._delays));
+  EXPECT_GT(total(slow._delays), 2u * total(fake._delays));
+}
+
+TEST(Timing, compile_time_profile) {
+  FastTx tx;
+  EXPECT_EQ(tx.timing(), fast_timing);
+
+  ASSERT_TRUE(tx.writeCv(3u, 42u));
+  EXPECT_EQ(tx._delays, std::vector<uint32_t>(8uz, 5u));
+}
+
+TEST(Timing, entry_half_period) {
+  TxFake fake;
+  fake.timing({.entry_half_period_us = 1000u,
+               .resync_pause_us = 10u,
+               .clock_high_us = 10u,
+               .clock_low_us = 20u});
+  fake.enter();
+
+  EXPECT_EQ(std::ranges::count(fake._delays, 1000u), 200);
+  EXPECT_EQ(fake._delays.back(), zusi::resync_timeout_us);
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include "tx_fake.hpp"
+
+TEST(TxTrace, record_replay) {
+  TxFake fake;
+  fake._cvs[8uz] = 145u;
+  std::vector<uint8_t> trace;
+  {
+    zusi::tx::Recorder recorder{fake, trace};
+    EXPECT_EQ(recorder.readCv(8u), 145u);
+    EXPECT_TRUE(recorder.writeCv(8u, 1u));
+  }
+  EXPECT_EQ(fake._cvs[8uz], 1u);
+
+  zusi::tx::Replayer replayer{trace};
+  EXPECT_EQ(replayer.readCv(8u), 145u);
+  EXPECT_TRUE(replayer.writeCv(8u, 1u));
+  EXPECT_FALSE(replayer.mismatch());
+  EXPECT_TRUE(replayer.done());
+}
+
+TEST(TxTrace, replay_mismatch) {
+  TxFake fake;
+  std::vector<uint8_t> trace;
+  zusi::tx::Recorder recorder{fake, trace};
+  EXPECT_TRUE(recorder.readCv(8u));
+
+  zusi::tx::Replayer replayer{trace};
+  EXPECT_EQ(replayer.readCv(9u).error(), std::errc::connection_reset);
+  EXPECT_EQ(replayer.mismatch(), 0uz);
+  EXPECT_FALSE(replayer.done());
+}
@@ -0,0 +1,143 @@
+#include "tx_test.hpp"
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::InSequence;
+using ::testing::Ne;
+using ::testing::Return;
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::zusi::resync_byte;
+
+TEST_F(TxTest, transmit_cv_read_count) {
+  auto const packet{zusi::make_cv_read_packet(1u, _addr)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), Ne(_0_1)));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, readData()).Times(2 * 8);           // Receive data
+  EXPECT_CALL(_mock, readData()).Times(8);               // CRC8
+  EXPECT_CALL(_mock, spiMaster());
+
+  auto const feedback{_mock.transmit(packet)};
+  ASSERT_TRUE(feedback);
+  EXPECT_THAT(*feedback, ElementsAre(0x00u, 0x00u));
+}
+
+TEST_F(TxTest, transmit_cv_write_count) {
+  std::array<uint8_t, 3uz> const cvs{0x01u, 0x02u, 0x03u};
+  auto const packet{zusi::make_cv_write_packet(2u, _addr, cvs)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), Ne(_0_1)));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  auto const feedback{_mock.transmit(packet)};
+  ASSERT_TRUE(feedback);
+  EXPECT_TRUE(empty(*feedback));
+}
+
+TEST_F(TxTest, transmit_zpp_write_burst) {
+  std::array<uint8_t, 2uz * zusi::zpp_write_burst_block_size> bytes{};
+  bytes[0uz] = 0xAAu;
+  auto const header{zusi::make_zpp_write_burst_frame(1u, 0x0001'0000u)};
+  auto const block0{zusi::make_zpp_write_burst_block(
+    std::span{bytes}.first<zusi::zpp_write_burst_block_size>())};
+  auto const block1{zusi::make_zpp_write_burst_block(
+    std::span{bytes}.last<zusi::zpp_write_burst_block_size>())};
+  std::vector<uint8_t> packet{cbegin(header), cend(header)};
+  packet.insert(end(packet), cbegin(block0), cend(block0));
+  packet.insert(end(packet), cbegin(block1), cend(block1));
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(header), _0_286));
+  for (auto const& block : {block0, block1}) {
+    EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(block), _0_286));
+    EXPECT_CALL(_mock, gpioInput());
+    EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy of block
+    EXPECT_CALL(_mock, spiMaster());
+  }
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_TRUE(_mock.transmit(packet));
+}
+
+TEST_F(TxTest, transmit_ignores_trailing_bytes) {
+  auto packet{zusi::make_zpp_erase_packet()};
+  packet.push_back(0xFFu);
+
+  InSequence seq;
+  EXPECT_CALL(_mock,
+              transmitBytes(ElementsAreArray(zusi::zpp_erase_frame), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+
+  _mock.transmit(packet);
+}
+
+TEST_F(TxTest, transmit_rejects_malformed_packets) {
+  EXPECT_CALL(_mock, transmitBytes(_, _)).Times(0);
+
+  // Unknown command
+  std::array<uint8_t, 2uz> unknown{0x03u, zusi::crc8(0x03u)};
+  EXPECT_EQ(_mock.transmit(unknown).error(), std::errc::invalid_argument);
+
+  // CRC error
+  auto crc_error{zusi::make_exit_packet(_exit_flags)};
+  crc_error.back() ^= 0x01u;
+  EXPECT_EQ(_mock.transmit(crc_error).error(), std::errc::invalid_argument);
+
+  // Too short
+  auto const write{zusi::make_zpp_write_packet(
+    3u, 0x0001'0000u, std::array<uint8_t, 4uz>{1u, 2u, 3u, 4u})};
+  EXPECT_EQ(_mock.transmit(std::span{write}.first(size(write) - 1uz)).error(),
+            std::errc::invalid_argument);
+
+  // Response doesn't fit into feedback
+  auto const read{zusi::make_cv_read_packet(ZUSI_MAX_FEEDBACK_SIZE, _addr)};
+  EXPECT_EQ(_mock.transmit(read).error(), std::errc::value_too_large);
+}
+
+TEST(ValidatePacket, layout) {
+  auto const read{zusi::make_cv_read_packet(3u, 0u)};
+  auto const layout{zusi::tx::validate_packet(read)};
+  ASSERT_TRUE(layout);
+  EXPECT_EQ(layout->count, 4uz);
+  EXPECT_EQ(layout->frame_size, 7uz);
+  EXPECT_EQ(layout->size, 7uz);
+  EXPECT_EQ(layout->response_size, 4uz + 1uz);
+
+  std::array<uint8_t, 256uz> bytes{};
+  auto const write{zusi::make_zpp_write_fec_packet(255u, 0u, bytes)};
+  auto const parity{zusi::make_zpp_write_fec_parity(write)};
+  std::vector<uint8_t> fec{cbegin(write), cend(write)};
+  fec.insert(end(fec), cbegin(parity), cend(parity));
+  auto const fec_layout{zusi::tx::validate_packet(fec)};
+  ASSERT_TRUE(fec_layout);
+  EXPECT_EQ(fec_layout->frame_size, size(write));
+  EXPECT_EQ(fec_layout->size, size(write) + zusi::fec_parity_size);
+  EXPECT_EQ(fec_layout->response_size, 0uz);
+}
+
+TEST(ValidatePacket, all_commands_known) {
+  for (auto cmd{std::to_underlying(zusi::Command::CvRead)};
+       cmd <= std::to_underlying(zusi::Command::ZppCopy);
+       ++cmd)
+    EXPECT_EQ(zusi::tx::command_phases(zusi::Command{cmd}).size != 0uz,
+              cmd != 0x03u);
+}
@@ -0,0 +1,119 @@
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::zusi::resync_byte;
+
+namespace {
+
+// Transmitter which exposes validation and busy phase
+class TxBatchMock : public TxMock {
+public:
+  MOCK_METHOD(uint8_t,
+              accumulateCrc8,
+              (std::span<uint8_t const>, uint8_t),
+              (const, override));
+  MOCK_METHOD(void, busy, (), (const, override));
+};
+
+struct TxBatchTest : ::testing::Test {
+protected:
+  TxBatchTest() {
+    ON_CALL(_mock, accumulateCrc8(_, _))
+      .WillByDefault([](std::span<uint8_t const> bytes, uint8_t crc) {
+        return zusi::crc8(bytes, crc);
+      });
+  }
+
+  // Acknowledge every packet
+  void ackAll() {
+    EXPECT_CALL(_mock, transmitBytes(_, _)).Times(AnyNumber());
+    EXPECT_CALL(_mock, readData()).WillRepeatedly([this] { return ack(); });
+  }
+
+  // Alternate ACK valid and ACK
+  bool ack() { return _reads++ % 2uz; }
+
+  size_t _reads{};
+  NiceMock<TxBatchMock> _mock;
+  std::array<zusi::Packet, 3uz> _packets{
+    zusi::make_cv_write_packet(0u, 0u, std::array<uint8_t, 1uz>{42u}),
+    zusi::make_zpp_erase_packet(),
+    zusi::make_exit_packet(0u)};
+  std::array<zusi::Feedback, 3uz> _feedbacks{};
+};
+
+} // namespace
+
+TEST_F(TxBatchTest, all_packets) {
+  ackAll();
+  for (auto const& packet : _packets)
+    EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), _0_286));
+
+  EXPECT_EQ(_mock.transmit(_packets, _feedbacks), size(_packets));
+  for (auto const& feedback : _feedbacks) {
+    ASSERT_TRUE(feedback);
+    EXPECT_TRUE(empty(*feedback));
+  }
+}
+
+TEST_F(TxBatchTest, next_packet_validated_while_busy) {
+  ackAll();
+  InSequence seq;
+  EXPECT_CALL(_mock, accumulateCrc8(ElementsAreArray(_packets[0uz]), 0u));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(_packets[0uz]), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, accumulateCrc8(ElementsAreArray(_packets[1uz]), 0u));
+  EXPECT_CALL(_mock, busy());
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(_packets[1uz]), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, accumulateCrc8(ElementsAreArray(_packets[2uz]), 0u));
+  EXPECT_CALL(_mock, busy());
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(_packets[2uz]), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, busy());
+
+  EXPECT_EQ(_mock.transmit(_packets, _feedbacks), size(_packets));
+}
+
+TEST_F(TxBatchTest, stop_on_error) {
+  ackAll();
+  _packets[1uz].back() ^= 0xFFu;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(_packets[0uz]), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(_packets[1uz]), _))
+    .Times(0);
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(_packets[2uz]), _))
+    .Times(0);
+
+  EXPECT_EQ(_mock.transmit(_packets, _feedbacks), 2uz);
+  EXPECT_TRUE(_feedbacks[0uz]);
+  EXPECT_EQ(_feedbacks[1uz].error(), std::errc::invalid_argument);
+}
+
+TEST_F(TxBatchTest, keep_going) {
+  ackAll();
+  EXPECT_CALL(_mock, readData())
+    .WillOnce(Return(false)) // ACK valid
+    .WillOnce(Return(false)) // NAK
+    .WillRepeatedly([this] { return ack(); });
+  for (auto const& packet : _packets)
+    EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), _0_286));
+
+  EXPECT_EQ(_mock.transmit(_packets, _feedbacks, false), size(_packets));
+  EXPECT_EQ(_feedbacks[0uz].error(), std::errc::protocol_error);
+  EXPECT_TRUE(_feedbacks[1uz]);
+  EXPECT_TRUE(_feedbacks[2uz]);
+}
+
+TEST_F(TxBatchTest, framed_image) {
+  ackAll();
+  std::array<uint8_t, 300uz> bytes{};
+  zusi::tx::FramedImage const framed{0x0001'0000u, bytes};
+  std::array<zusi::Feedback, 2uz> feedbacks{};
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(framed[0uz]), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(framed[1uz]), _0_286));
+
+  EXPECT_EQ(_mock.transmit(framed, feedbacks), framed.size());
+  EXPECT_TRUE(feedbacks[0uz]);
+  EXPECT_TRUE(feedbacks[1uz]);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <deque>
+#include <vector>
+#include <zusi/zusi.hpp>
+
+// Decoder simulated at the level of tx::Base hardware virtuals
+class TxFake : public zusi::tx::Base {
+public:
+  mutable std::array<uint8_t, 1024uz> _cvs{};
+  mutable std::vector<uint8_t> _flash{};
+  mutable std::vector<std::vector<uint8_t>> _frames{};
+  mutable std::vector<uint32_t> _delays{};
+  bool _single_cv{}; // Legacy decoder which ignores the CV count
+  zusi::Capabilities _caps{.cv_multiple = true}; // Answer to Capabilities
+
+private:
+  void transmitBytes(std::span<uint8_t const> bytes,
+                     zusi::Mbps mbps) const override {
+    if (mbps == zusi::Mbps::_0_1) return; // Resync
+    _frames.emplace_back(cbegin(bytes), cend(bytes));
+    _bits.clear();
+    auto const cmd{static_cast<zusi::Command>(bytes[zusi::cmd_pos])};
+    // Legacy decoders don't know Capabilities and stay silent
+    if (_single_cv && cmd == zusi::Command::Capabilities) return;
+    respond(false); // ACK valid
+    respond(true);  // ACK
+    respond(true);  // Busy
+    if (cmd == zusi::Command::Capabilities) {
+      auto const caps{zusi::capabilities2data(_caps)};
+      for (auto const byte : caps) respond(byte);
+      for (auto const byte : caps) respond(byte);
+      return;
+    }
+    // Short frames (e.g. Exit) carry no address
+    if (size(bytes) < zusi::data_pos) return;
+    auto const addr{zusi::data2uint32(&bytes[zusi::addr_pos])};
+    size_t const count{_single_cv ? 1uz : bytes[zusi::data_cnt_pos] + 1uz};
+    switch (cmd) {
+      case zusi::Command::CvRead:
+        for (auto i{0uz}; i < count; ++i) respond(_cvs[addr + i]);
+        respond(zusi::crc8({&_cvs[addr], count}));
+        break;
+      case zusi::Command::CvWrite:
+        std::copy_n(&bytes[zusi::data_pos], count, &_cvs[addr]);
+        break;
+      case zusi::Command::ZppWrite:
+        if (size(_flash) < addr + count) _flash.resize(addr + count, 0xFFu);
+        std::copy_n(&bytes[zusi::data_pos], count, &_flash[addr]);
+        break;
+      case zusi::Command::ZppCrc32Query: {
+        auto const first{zusi::data2uint32(&bytes[1uz])};
+        auto const length{zusi::data2uint32(&bytes[5uz])};
+        if (size(_flash) < first + length) _flash.resize(first + length, 0xFFu);
+        std::array<uint8_t, 4uz> crc{};
+        zusi::uint32_2data(zusi::crc32({&_flash[first], length}), begin(crc));
+        for (auto const byte : crc) respond(byte);
+        respond(zusi::crc8(crc));
+        break;
+      }
+      default: break;
+    }
+  }
+
+  void spiMaster() const override {}
+  void gpioInput() const override {}
+  void gpioOutput() const override {}
+  void writeClock(bool) const override {}
+  void writeData(bool) const override {}
+
+  bool readData() const override {
+    if (empty(_bits)) return true;
+    auto const bit{_bits.front()};
+    _bits.pop_front();
+    return bit;
+  }
+
+  void delayUs(uint32_t us) const override { _delays.push_back(us); }
+
+  void respond(bool bit) const { _bits.push_back(bit); }
+
+  void respond(uint8_t byte) const {
+    for (auto i{0uz}; i < CHAR_BIT; ++i)
+      respond(static_cast<bool>(byte >> i & 1u));
+  }
+
+  mutable std::deque<bool> _bits{};
+};
@@ -0,0 +1,85 @@
+#include <numeric>
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::zusi::resync_byte;
+using ::zusi::tx::find_duplicate_blocks;
+
+namespace {
+
+// Image made of blocks filled with the given values
+std::vector<uint8_t> make_image(std::initializer_list<uint8_t> values,
+                                size_t block_size = 256uz) {
+  std::vector<uint8_t> bytes;
+  for (auto const value : values) bytes.insert(end(bytes), block_size, value);
+  return bytes;
+}
+
+} // namespace
+
+TEST_F(TxTest, zpp_copy_ack) {
+  InSequence seq;
+  EXPECT_CALL(_mock,
+              transmitBytes(ElementsAreArray(zusi::make_zpp_copy_frame(
+                              0x0001'0000u, 0x0001'0400u, 0x200u)),
+                            Ne(_0_1)));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_TRUE(_mock.copyZpp(0x0001'0000u, 0x0001'0400u, 0x200u));
+}
+
+TEST_F(TxTest, zpp_copy_transmit) {
+  auto const packet{zusi::make_zpp_copy_packet(0u, 0x100u, 0x100u)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), Ne(_0_1)));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData()); // ACK valid
+  EXPECT_CALL(_mock, readData()); // NAK
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_EQ(_mock.transmit(packet).error(), std::errc::protocol_error);
+}
+
+TEST(ZppCopy, frame) {
+  auto const frame{
+    zusi::make_zpp_copy_frame(0x0102'0304u, 0x0506'0708u, 0x100u)};
+  EXPECT_EQ(frame[0uz], 0x0Fu);
+  EXPECT_EQ(zusi::data2uint32(&frame[1uz]), 0x0102'0304u);
+  EXPECT_EQ(zusi::data2uint32(&frame[5uz]), 0x0506'0708u);
+  EXPECT_EQ(zusi::data2uint32(&frame[9uz]), 0x100u);
+  EXPECT_FALSE(zusi::crc8(frame));
+}
+
+TEST(ZppCopy, features_flag) {
+  EXPECT_FALSE(zusi::zpp_copy_supported({0xFFu, 0xFFu, 0xFFu, 0xFFu}));
+  EXPECT_TRUE(zusi::zpp_copy_supported({0xFFu, 0xBFu, 0xFFu, 0xFFu}));
+}
+
+TEST(ZppCopy, no_duplicates) {
+  std::vector<uint8_t> bytes(4uz * 256uz);
+  std::iota(begin(bytes), end(bytes), 0u);
+  for (auto i{0uz}; i < size(bytes); ++i) bytes[i] ^= static_cast<uint8_t>(i / 256uz);
+  EXPECT_TRUE(empty(find_duplicate_blocks(0u, bytes)));
+}
+
+TEST(ZppCopy, find_duplicate_blocks) {
+  auto const bytes{make_image({1u, 2u, 1u, 2u, 3u, 1u, 3u})};
+  EXPECT_EQ(find_duplicate_blocks(0x0001'0000u, bytes),
+            (std::vector<zusi::tx::ZppCopy>{
+              {.src = 0x0001'0000u, .dst = 0x0001'0200u, .size = 0x200u},
+              {.src = 0x0001'0000u, .dst = 0x0001'0500u, .size = 0x100u},
+              {.src = 0x0001'0400u, .dst = 0x0001'0600u, .size = 0x100u}}));
+}
+
+TEST(ZppCopy, partial_last_block_is_ignored) {
+  auto bytes{make_image({7u, 7u})};
+  bytes.resize(size(bytes) - 1uz);
+  EXPECT_TRUE(empty(find_duplicate_blocks(0u, bytes)));
+}
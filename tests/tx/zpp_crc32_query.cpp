@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include "tx_fake.hpp"
+
+using zusi::tx::ZppRange;
+
+namespace {
+
+std::vector<uint8_t> make_image(size_t count) {
+  std::vector<uint8_t> bytes(count);
+  std::iota(begin(bytes), end(bytes), 0u);
+  return bytes;
+}
+
+void write_image(TxFake& fake, std::span<uint8_t const> bytes) {
+  for (auto i{0uz}; i < size(bytes); i += 256uz)
+    ASSERT_TRUE(fake.writeZpp(static_cast<uint32_t>(i),
+                              bytes.subspan(i, 256uz)));
+}
+
+} // namespace
+
+TEST(ZppCrc32Query, crc32_query) {
+  TxFake fake;
+  auto const image{make_image(1024uz)};
+  write_image(fake, image);
+
+  auto const crc{fake.crc32Query(256u, 512u)};
+  ASSERT_TRUE(crc);
+  EXPECT_EQ(*crc, zusi::crc32(std::span{image}.subspan(256uz, 512uz)));
+  EXPECT_TRUE(std::ranges::equal(fake._frames.back(),
+                                 zusi::make_zpp_crc32_query_frame(256u, 512u)));
+}
+
+TEST(ZppCrc32Query, verify_range) {
+  TxFake fake;
+  auto const image{make_image(1024uz)};
+  write_image(fake, image);
+
+  EXPECT_TRUE(fake.verifyRange(0u, image).value());
+  fake._flash[700uz] ^= 0xFFu;
+  EXPECT_FALSE(fake.verifyRange(0u, image).value());
+}
+
+TEST(ZppCrc32Query, find_bad_ranges) {
+  TxFake fake;
+  auto const image{make_image(64uz * 1024uz)};
+  write_image(fake, image);
+
+  auto const none{zusi::tx::find_bad_ranges(fake, 0u, image)};
+  ASSERT_TRUE(none);
+  EXPECT_TRUE(empty(*none));
+
+  // Two adjacent bad blocks and a single one further up
+  fake._flash[0x1000uz] ^= 0xFFu;
+  fake._flash[0x11FFuz] ^= 0xFFu;
+  fake._flash[0x8010uz] ^= 0xFFu;
+  fake._frames.clear();
+  auto const bad{zusi::tx::find_bad_ranges(fake, 0u, image)};
+  ASSERT_TRUE(bad);
+  EXPECT_EQ(*bad,
+            (std::vector<ZppRange>{{.addr = 0x1000u, .size = 0x200uz},
+                                   {.addr = 0x8000u, .size = 0x100uz}}));
+  // Bisection needs far fewer queries than there are blocks
+  EXPECT_LT(size(fake._frames), 64uz);
+}
+
+TEST(ZppCrc32Query, features_flag) {
+  EXPECT_FALSE(zusi::zpp_crc32_query_supported({0xFFu, 0xFFu, 0xFFu, 0xFFu}));
+  EXPECT_TRUE(zusi::zpp_crc32_query_supported({0xFFu, 0xFBu, 0xFFu, 0xFFu}));
+}
@@ -0,0 +1,49 @@
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::zusi::resync_byte;
+
+TEST_F(TxTest, zpp_erase_range_ack) {
+  InSequence seq;
+  EXPECT_CALL(_mock,
+              transmitBytes(ElementsAreArray(zusi::make_zpp_erase_range_frame(
+                              0x0001'0000u, 0x4000u)),
+                            Ne(_0_1)));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_TRUE(_mock.eraseZpp(0x0001'0000u, 0x4000u));
+}
+
+TEST_F(TxTest, zpp_erase_range_transmit) {
+  auto const packet{zusi::make_zpp_erase_range_packet(0x0001'0000u, 0x4000u)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), Ne(_0_1)));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData()); // ACK valid
+  EXPECT_CALL(_mock, readData()); // NAK
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_EQ(_mock.transmit(packet).error(), std::errc::protocol_error);
+}
+
+TEST(ZppEraseRange, frame) {
+  auto const frame{zusi::make_zpp_erase_range_frame(0x0102'0304u, 0x100u)};
+  EXPECT_EQ(frame[0uz], 0x0Bu);
+  EXPECT_EQ(frame[1uz], 0x55u);
+  EXPECT_EQ(frame[2uz], 0xAAu);
+  EXPECT_EQ(zusi::data2uint32(&frame[3uz]), 0x0102'0304u);
+  EXPECT_EQ(zusi::data2uint32(&frame[7uz]), 0x100u);
+  EXPECT_FALSE(zusi::crc8(frame));
+}
+
+TEST(ZppEraseRange, features_flag) {
+  EXPECT_FALSE(zusi::zpp_erase_range_supported({0xFFu, 0xFFu, 0xFFu, 0xFFu}));
+  EXPECT_TRUE(zusi::zpp_erase_range_supported({0xFFu, 0xEFu, 0xFFu, 0xFFu}));
+}
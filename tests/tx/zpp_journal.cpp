@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <zusi/zusi.hpp>
+
+using zusi::tx::parse_zpp_journal;
+using zusi::tx::resume_address;
+using zusi::tx::ZppJournal;
+using zusi::tx::ZppSession;
+
+namespace {
+
+ZppSession const session{.image_crc = 0xDEADBEEFu,
+                         .image_size = 0x1000u,
+                         .features = {0xF8u, 0xF8u, 0xFFu, 0xFFu},
+                         .developer_code = {0x01u, 0x02u, 0x03u, 0x04u},
+                         .load_code_valid = true};
+
+std::vector<uint8_t> make_journal(std::initializer_list<uint32_t> addrs) {
+  std::vector<uint8_t> bytes;
+  ZppJournal journal{[&](std::span<uint8_t const> chunk) {
+                       bytes.insert(end(bytes), cbegin(chunk), cend(chunk));
+                     },
+                     session};
+  for (auto const addr : addrs) journal.acknowledged(addr);
+  return bytes;
+}
+
+} // namespace
+
+TEST(ZppJournal, round_trip) {
+  auto const state{parse_zpp_journal(make_journal({256u, 512u, 768u}))};
+  ASSERT_TRUE(state);
+  EXPECT_EQ(state->session, session);
+  EXPECT_EQ(state->acknowledged, 768u);
+  EXPECT_EQ(resume_address(*state, session), 768u);
+}
+
+TEST(ZppJournal, header_only_resumes_at_start) {
+  auto const state{parse_zpp_journal(make_journal({}))};
+  ASSERT_TRUE(state);
+  EXPECT_FALSE(state->acknowledged);
+  EXPECT_EQ(resume_address(*state, session), 0u);
+}
+
+TEST(ZppJournal, torn_record_ignored) {
+  auto bytes{make_journal({256u, 512u})};
+  bytes.pop_back();
+  auto state{parse_zpp_journal(bytes)};
+  ASSERT_TRUE(state);
+  EXPECT_EQ(state->acknowledged, 256u);
+
+  // Corrupt record stops parsing even if further records follow
+  bytes = make_journal({256u, 512u, 768u});
+  bytes[size(bytes) - 7uz] ^= 0xFFu;
+  state = parse_zpp_journal(bytes);
+  ASSERT_TRUE(state);
+  EXPECT_EQ(state->acknowledged, 256u);
+}
+
+TEST(ZppJournal, session_mismatch) {
+  auto const state{parse_zpp_journal(make_journal({256u}))};
+  ASSERT_TRUE(state);
+
+  auto other{session};
+  other.image_crc = 0u;
+  EXPECT_FALSE(resume_address(*state, other));
+  other = session;
+  other.features[1uz] = 0xFAu;
+  EXPECT_FALSE(resume_address(*state, other));
+  other = session;
+  other.load_code_valid = false;
+  EXPECT_FALSE(resume_address(*state, other));
+}
+
+TEST(ZppJournal, invalid_header) {
+  EXPECT_EQ(parse_zpp_journal({}).error(), std::errc::invalid_argument);
+
+  auto bytes{make_journal({})};
+  bytes.front() = 'X';
+  EXPECT_EQ(parse_zpp_journal(bytes).error(), std::errc::invalid_argument);
+
+  bytes = make_journal({});
+  bytes[4uz] ^= 0x01u;
+  EXPECT_EQ(parse_zpp_journal(bytes).error(), std::errc::bad_message);
+}
@@ -0,0 +1,74 @@
+#include <numeric>
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::zusi::resync_byte;
+
+namespace {
+
+std::vector<uint8_t> make_blocks(size_t count) {
+  std::vector<uint8_t> bytes(count * zusi::zpp_write_burst_block_size);
+  std::iota(begin(bytes), end(bytes), 0u);
+  return bytes;
+}
+
+// Every block is followed by a busy phase of its own
+void expect_blocks(NiceMock<TxMock>& mock, size_t count) {
+  for (auto i{0uz}; i < count; ++i) {
+    EXPECT_CALL(mock, transmitBytes(SizeIs(257uz), _0_286));
+    EXPECT_CALL(mock, gpioInput());
+    EXPECT_CALL(mock, readData()).WillOnce(Return(true)); // Busy
+    EXPECT_CALL(mock, spiMaster());
+  }
+}
+
+} // namespace
+
+TEST_F(TxTest, zpp_write_burst_ack) {
+  auto const bytes{make_blocks(2uz)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock,
+              transmitBytes(ElementsAreArray(zusi::make_zpp_write_burst_frame(
+                              1u, 0x0001'0000u)),
+                            _0_286));
+  expect_blocks(_mock, 2uz);
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_TRUE(_mock.writeZppBurst(0x0001'0000u, bytes));
+}
+
+TEST_F(TxTest, zpp_write_burst_nak) {
+  auto const bytes{make_blocks(3uz)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(SizeIs(7uz), _0_286));
+  expect_blocks(_mock, 3uz);
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData()); // ACK valid
+  EXPECT_CALL(_mock, readData()); // NAK
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_EQ(_mock.writeZppBurst(0u, bytes).error(),
+            std::errc::protocol_error);
+}
+
+TEST(ZppWriteBurst, block_frame_has_crc) {
+  std::array<uint8_t, zusi::zpp_write_burst_block_size> block{};
+  std::iota(begin(block), end(block), 0u);
+  auto const frame{zusi::make_zpp_write_burst_block(block)};
+  EXPECT_TRUE(std::ranges::equal(block, std::span{frame}.first<256uz>()));
+  EXPECT_EQ(zusi::crc8(frame), 0u);
+}
+
+TEST(ZppWriteBurst, features_flag) {
+  EXPECT_FALSE(zusi::zpp_write_burst_supported({0xFFu, 0xFFu, 0xFFu, 0xFFu}));
+  EXPECT_TRUE(zusi::zpp_write_burst_supported({0xFFu, 0xFEu, 0xFFu, 0xFFu}));
+}
@@ -0,0 +1,73 @@
+#include <numeric>
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::zusi::resync_byte;
+
+TEST_F(TxTest, zpp_write_compressed_ack) {
+  std::array<uint8_t, 256uz> bytes{};
+  bytes.fill(0xFFu);
+  std::array<uint8_t, 255uz> compressed{};
+  auto const count{zusi::compress(bytes, compressed)};
+  ASSERT_TRUE(count);
+
+  InSequence seq;
+  EXPECT_CALL(
+    _mock,
+    transmitBytes(
+      ElementsAreArray(zusi::make_zpp_write_compressed_packet(
+        0x0001'0000u, std::span{compressed}.first(count))),
+      _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_TRUE(_mock.writeZppCompressed(0x0001'0000u, bytes));
+}
+
+TEST_F(TxTest, zpp_write_compressed_falls_back_to_zpp_write) {
+  std::array<uint8_t, 256uz> bytes{};
+  std::iota(begin(bytes), end(bytes), 0u);
+
+  InSequence seq;
+  EXPECT_CALL(_mock,
+              transmitBytes(ElementsAreArray(zusi::make_zpp_write_frame(
+                              0x0001'0000u, std::span<uint8_t const>{bytes}
+                                              .first<256uz>())),
+                            _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_TRUE(_mock.writeZppCompressed(0x0001'0000u, bytes));
+}
+
+TEST_F(TxTest, zpp_write_compressed_transmit_packet) {
+  std::array<uint8_t, 4uz> const compressed{0xBFu, 0u, 0xBFu, 0u};
+  auto const packet{
+    zusi::make_zpp_write_compressed_packet(0x0001'0000u, compressed)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData()); // ACK valid
+  EXPECT_CALL(_mock, readData()); // NAK
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_EQ(_mock.transmit(packet).error(), std::errc::protocol_error);
+}
+
+TEST(ZppWriteCompressed, features_flag) {
+  EXPECT_FALSE(
+    zusi::zpp_write_compressed_supported({0xFFu, 0xFFu, 0xFFu, 0xFFu}));
+  EXPECT_TRUE(
+    zusi::zpp_write_compressed_supported({0xFFu, 0xFDu, 0xFFu, 0xFFu}));
+}
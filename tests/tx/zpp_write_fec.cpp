@@ -0,0 +1,83 @@
+#include <numeric>
+#include "tx_test.hpp"
+
+using ::Mbps::_0_1;
+using ::Mbps::_0_286;
+using ::zusi::resync_byte;
+
+namespace {
+
+std::array<uint8_t, 256uz> make_block() {
+  std::array<uint8_t, 256uz> bytes;
+  std::iota(begin(bytes), end(bytes), 0u);
+  return bytes;
+}
+
+} // namespace
+
+TEST_F(TxTest, zpp_write_fec_ack) {
+  auto const bytes{make_block()};
+  auto const packet{zusi::make_zpp_write_fec_packet(255u, 0x0001'0000u, bytes)};
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), _0_286));
+  EXPECT_CALL(_mock,
+              transmitBytes(
+                ElementsAreArray(zusi::make_zpp_write_fec_parity(packet)),
+                _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData());                        // ACK valid
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // ACK
+  EXPECT_CALL(_mock, readData()).WillOnce(Return(true)); // Busy
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_TRUE(_mock.writeZppFec(0x0001'0000u, bytes));
+}
+
+TEST_F(TxTest, zpp_write_fec_transmit_frame) {
+  auto const bytes{make_block()};
+  auto const packet{zusi::make_zpp_write_fec_packet(
+    3u, 0x0001'0000u, std::span{bytes}.first(4uz))};
+  auto const parity{zusi::make_zpp_write_fec_parity(packet)};
+  std::vector<uint8_t> frame{cbegin(packet), cend(packet)};
+  frame.insert(end(frame), cbegin(parity), cend(parity));
+
+  InSequence seq;
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(packet), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAreArray(parity), _0_286));
+  EXPECT_CALL(_mock, transmitBytes(ElementsAre(resync_byte), _0_1));
+  EXPECT_CALL(_mock, gpioInput());
+  EXPECT_CALL(_mock, readData()); // ACK valid
+  EXPECT_CALL(_mock, readData()); // NAK
+  EXPECT_CALL(_mock, spiMaster());
+
+  ASSERT_EQ(_mock.transmit(frame).error(), std::errc::protocol_error);
+}
+
+// Packet can't hold a full block plus parity, so it rejects ZPP-Write-FEC
+TEST_F(TxTest, zpp_write_fec_transmit_packet) {
+  auto const bytes{make_block()};
+  auto const packet{zusi::make_zpp_write_fec_packet(
+    3u, 0x0001'0000u, std::span{bytes}.first(4uz))};
+  auto const parity{zusi::make_zpp_write_fec_parity(packet)};
+  zusi::Packet frame{cbegin(packet), cend(packet)};
+  frame.insert(end(frame), cbegin(parity), cend(parity));
+
+  EXPECT_CALL(_mock, transmitBytes(_, _)).Times(0);
+
+  ASSERT_EQ(_mock.transmit(frame).error(), std::errc::not_supported);
+}
+
+TEST(ZppWriteFec, packet) {
+  auto const bytes{make_block()};
+  auto const packet{zusi::make_zpp_write_fec_packet(255u, 0x0001'0000u, bytes)};
+  auto const zpp_write{zusi::make_zpp_write_packet(255u, 0x0001'0000u, bytes)};
+
+  EXPECT_EQ(packet[0uz], std::to_underlying(zusi::Command::ZppWriteFec));
+  EXPECT_TRUE(std::equal(cbegin(packet) + 1,
+                         cend(packet) - 1,
+                         cbegin(zpp_write) + 1,
+                         cend(zpp_write) - 1));
+  EXPECT_FALSE(zusi::crc8(packet));
+}
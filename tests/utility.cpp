@@ -0,0 +1,53 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <zusi/zusi.hpp>
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+// Constant frames must be folded at compile time
+static_assert(zusi::features_frame == zusi::Frame<2uz>{0x06u, 0xDDu});
+static_assert(zusi::zpp_erase_frame ==
+              zusi::Frame<4uz>{0x04u, 0x55u, 0xAAu, 0xC7u});
+
+TEST(utility, cv_read_frame) {
+  auto const frame{zusi::make_cv_read_frame(0u, 0x0000'00FFu)};
+  EXPECT_THAT(frame,
+              ElementsAre(0x01u, 0x00u, 0x00u, 0x00u, 0x00u, 0xFFu, 0x02u));
+  EXPECT_THAT(frame,
+              ElementsAreArray(zusi::make_cv_read_packet(0u, 0x0000'00FFu)));
+}
+
+TEST(utility, cv_write_frame) {
+  auto const frame{zusi::make_cv_write_frame(0x0000'00FFu, 0x0Fu)};
+  EXPECT_THAT(
+    frame,
+    ElementsAre(0x02u, 0x00u, 0x00u, 0x00u, 0x00u, 0xFFu, 0x0Fu, 0xBAu));
+  std::array<uint8_t, 1uz> const values{0x0Fu};
+  EXPECT_THAT(frame,
+              ElementsAreArray(
+                zusi::make_cv_write_packet(0u, 0x0000'00FFu, values)));
+}
+
+TEST(utility, zpp_write_frame) {
+  std::array<uint8_t, 256uz> bytes{};
+  std::iota(begin(bytes), end(bytes), 0u);
+  std::span<uint8_t const, 256uz> const chunk{bytes};
+  auto const frame{zusi::make_zpp_write_frame(0x0001'0000u, chunk)};
+  static_assert(size(frame) == 263uz);
+  EXPECT_THAT(
+    frame,
+    ElementsAreArray(zusi::make_zpp_write_packet(255u, 0x0001'0000u, bytes)));
+}
+
+TEST(utility, exit_frame) {
+  EXPECT_THAT(zusi::make_exit_frame(0x02u),
+              ElementsAreArray(zusi::make_exit_packet(0x02u)));
+}
+
+TEST(utility, zpp_lc_dc_query_frame) {
+  std::array<uint8_t, 4uz> const developer_code{1u, 2u, 3u, 4u};
+  EXPECT_THAT(zusi::make_zpp_lc_dc_query_frame(developer_code),
+              ElementsAreArray(zusi::make_zpp_lc_dc_query_packet(0x01020304u)));
+}